@@ -1,2 +1,65 @@
 #include "at.h"
 
+uint8_t at_fmt_uint( char *buf, uint32_t value ) {
+
+  char digits[ AT_UINT_MAX_DIGITS ];
+  uint8_t n = 0;
+
+  // digits are generated in reverse order
+  do {
+    digits[ n++ ] = '0' + ( value % 10 );
+    value /= 10;
+  } while ( value > 0 );
+
+  for ( uint8_t i = 0; i < n; i++ ) {
+    buf[ i ] = digits[ n - i - 1 ];
+  }
+
+  return n;
+}
+
+uint8_t at_parse_uints( 
+  const char *str, const char *prefix, 
+  uint16_t *fields, const uint16_t *max, uint8_t n_fields 
+) {
+
+  while ( *prefix ) {
+    if ( *str++ != *prefix++ ) {
+      return 0;
+    }
+  }
+
+  for ( uint8_t i = 0; i < n_fields; i++ ) {
+
+    if ( i > 0 ) {
+      if ( *str != ',' ) {
+        return i;
+      }
+      str++;
+    }
+
+    while ( *str == ' ' ) {
+      str++;
+    }
+
+    if ( *str < '0' || *str > '9' ) {
+      return i;
+    }
+
+    uint32_t value = 0;
+    uint16_t value_max = max ? max[ i ] : UINT16_MAX;
+
+    while ( *str >= '0' && *str <= '9' ) {
+      
+      value = value * 10 + ( *str++ - '0' );
+
+      if ( value > value_max ) {
+        return i;
+      }
+    }
+
+    fields[ i ] = value;
+  }
+
+  return n_fields;
+}
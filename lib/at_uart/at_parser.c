@@ -0,0 +1,299 @@
+#include <string.h>
+#include <zephyr/sys/util.h>
+
+#include "at_parser.h"
+
+#define STR_EQ( str, len, lit ) \
+  ( (len) == sizeof( lit ) - 1 && memcmp( str, lit, sizeof( lit ) - 1 ) == 0 )
+
+#define STR_PREFIX( str, len, lit ) \
+  ( (len) >= sizeof( lit ) - 1 && memcmp( str, lit, sizeof( lit ) - 1 ) == 0 )
+
+/**
+ * @brief Looks up a verbose result code. Lines are dispatched by their
+ * length and first char, so at most one comparison is done per line
+ */
+static inline bool _vcode_lookup( const char *str, uint16_t len, at_code_t *code ) {
+
+  switch ( len ) {
+    
+    case 2:
+      *code = AT_CODE_OK;
+      return STR_EQ( str, len, "OK" );
+
+    case 4:
+      if ( str[ 0 ] == 'R' ) {
+        *code = AT_CODE_RING;
+        return STR_EQ( str, len, "RING" );
+      }
+      *code = AT_CODE_BUSY;
+      return STR_EQ( str, len, "BUSY" );
+
+    case 5:
+      if ( str[ 0 ] == 'E' ) {
+        *code = AT_CODE_ERROR;
+        return STR_EQ( str, len, "ERROR" );
+      }
+      *code = AT_CODE_READY;
+      return STR_EQ( str, len, "READY" );
+
+    case 7:
+      if ( str[ 0 ] == 'C' ) {
+        *code = AT_CODE_CONNECT;
+        return STR_EQ( str, len, "CONNECT" );
+      }
+      *code = AT_CODE_SBDRING;
+      return STR_EQ( str, len, "SBDRING" );
+
+    case 9:
+      *code = AT_CODE_NO_ANSWER;
+      return STR_EQ( str, len, "NO ANSWER" );
+
+    case 10:
+      *code = AT_CODE_NO_CARRIER;
+      return STR_EQ( str, len, "NO CARRIER" );
+
+    case 11:
+      *code = AT_CODE_NO_DIALTONE;
+      return STR_EQ( str, len, "NO DIALTONE" );
+
+    default:
+      // ! HARDWARE FAILURE: <subsys>,<error>
+      *code = AT_CODE_HW_FAILURE;
+      return STR_PREFIX( str, len, "HARDWARE FAILURE" );
+  }
+}
+
+/**
+ * @brief Looks up a numeric result code
+ */
+static inline bool _code_lookup( const char *str, uint16_t len, at_code_t *code ) {
+
+  if ( len == 1 ) {
+
+    if ( str[ 0 ] >= '0' && str[ 0 ] <= '8' && str[ 0 ] != '5' ) {
+      *code = str[ 0 ] - '0';
+      return true;
+    }
+
+    return false;
+
+  } else if ( len == 3 ) {
+
+    if ( STR_EQ( str, len, "126" ) ) {
+      *code = AT_CODE_SBDRING;
+      return true;
+    } else if ( STR_EQ( str, len, "127" ) ) {
+      *code = AT_CODE_HW_FAILURE;
+      return true;
+    }
+
+    return false;
+  }
+
+  // ! READY is always sent using its verbose form
+  *code = AT_CODE_READY;
+  return STR_EQ( str, len, "READY" );
+}
+
+bool at_code_lookup( const char *str, uint16_t len, bool verbose, at_code_t *code ) {
+
+  at_code_t _code;
+
+  bool found = verbose
+    ? _vcode_lookup( str, len, &_code )
+    : _code_lookup( str, len, &_code );
+
+  *code = found ? _code : AT_CODE_NONE;
+
+  return found;
+}
+
+/**
+ * @brief Discards URC prefixes which do not match the given line byte
+ * and keeps the beginning of the line, which is enough to recognize 
+ * result codes and to deliver URCs as a whole line
+ */
+static inline void _match_feed( at_parser_t *parser, unsigned char byte ) {
+
+  if ( parser->urc_mask ) {
+
+    for ( uint8_t i = 0; i < parser->n_urcs; i++ ) {
+      
+      const char *urc = parser->urcs[ i ];
+
+      // bytes beyond the prefix length are not checked, the prefix
+      // length is reached when the null terminated char is found
+      if ( ( parser->urc_mask & BIT( i ) ) 
+          && parser->line_len < strlen( urc )
+          && urc[ parser->line_len ] != byte ) {
+        WRITE_BIT( parser->urc_mask, i, 0 );
+      }
+    }
+  }
+
+  if ( parser->line_len < sizeof( parser->hold ) - 1 ) {
+    parser->hold[ parser->line_len ] = byte;
+  }
+
+  if ( parser->line_len < UINT16_MAX ) {
+    parser->line_len++;
+  }
+}
+
+static inline bool _urc_match_get( at_parser_t *parser ) {
+
+  for ( uint8_t i = 0; i < parser->n_urcs && parser->urc_mask; i++ ) {
+
+    if ( ( parser->urc_mask & BIT( i ) ) == 0 ) {
+      continue;
+    }
+
+    const char *urc = parser->urcs[ i ];
+    size_t urc_len = strlen( urc );
+
+    // ! Prefixes without parameters must match the whole line,
+    // ! otherwise a numeric URC like "126" would match unrelated lines
+    if ( urc_len > 0 && urc[ urc_len - 1 ] == ':' 
+        ? urc_len <= parser->line_len
+        : urc_len == parser->line_len ) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool at_parser_urc_possible( at_parser_t *parser ) {
+
+  for ( uint8_t i = 0; i < parser->n_urcs && parser->urc_mask; i++ ) {
+
+    if ( ( parser->urc_mask & BIT( i ) ) == 0 ) {
+      continue;
+    }
+
+    const char *urc = parser->urcs[ i ];
+    size_t urc_len = strlen( urc );
+
+    // whole line prefixes are discarded once the line is longer
+    if ( ( urc_len > 0 && urc[ urc_len - 1 ] == ':' ) 
+        || parser->line_len <= urc_len ) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * @brief Emits the token of the line which has just been completed
+ * 
+ * @return true The token handler requested to stop
+ */
+static bool _line_end( at_parser_t *parser ) {
+
+  uint16_t len = MIN( parser->line_len, sizeof( parser->hold ) - 1 );
+  parser->hold[ len ] = '\0';
+
+  at_parser_evt_t evt = { 
+    .tok = AT_PARSER_TOK_LINE,
+    .data = parser->hold,
+    .len = len,
+    .code = AT_CODE_NONE,
+  };
+
+  // registered URCs take precedence, as some of them are also result codes
+  if ( _urc_match_get( parser ) ) {
+    evt.tok = AT_PARSER_TOK_URC;
+  } else if ( at_code_lookup( parser->hold, parser->line_len, parser->verbose, &evt.code ) ) {
+    evt.tok = AT_PARSER_TOK_CODE;
+  }
+
+  at_parser_reset( parser );
+
+  return parser->cb( parser, &evt, parser->user_data );
+}
+
+/**
+ * @brief Emits a DATA token with the given fragment (if any)
+ */
+static inline void _data_emit( at_parser_t *parser, const uint8_t *data, uint32_t len ) {
+
+  if ( len == 0 ) {
+    return;
+  }
+
+  at_parser_evt_t evt = {
+    .tok = AT_PARSER_TOK_DATA,
+    .data = (const char*) data,
+    .len = len,
+  };
+
+  parser->cb( parser, &evt, parser->user_data );
+}
+
+void at_parser_init( 
+  at_parser_t *parser, bool verbose, at_parser_cb_t cb, void *user_data 
+) {
+  
+  *parser = (at_parser_t) {
+    .verbose = verbose,
+    // ! Verbose responses finish with <cr><lf> 
+    // ! and numeric ones only with <cr>
+    .eol = verbose ? '\n' : '\r',
+    .cb = cb,
+    .user_data = user_data,
+  };
+
+  at_parser_reset( parser );
+}
+
+void at_parser_set_urcs( 
+  at_parser_t *parser, const char *const *urcs, uint8_t n_urcs 
+) {
+  parser->urcs = urcs;
+  parser->n_urcs = MIN( n_urcs, AT_PARSER_MAX_MATCHES );
+  at_parser_reset( parser );
+}
+
+void at_parser_reset( at_parser_t *parser ) {
+  parser->line_len = 0;
+  parser->urc_mask = parser->n_urcs > 0 
+    ? BIT64_MASK( parser->n_urcs ) : 0;
+}
+
+uint32_t at_parser_feed( at_parser_t *parser, const uint8_t *bytes, uint32_t len ) {
+
+  // start of the current DATA fragment
+  uint32_t frag_i = 0;
+
+  parser->stopped = false;
+
+  for ( uint32_t i = 0; i < len; i++ ) {
+
+    unsigned char byte = bytes[ i ];
+
+    if ( byte != '\r' && byte != '\n' ) {
+      _match_feed( parser, byte );
+      continue;
+    }
+
+    // trailing chars are never emitted
+    _data_emit( parser, &bytes[ frag_i ], i - frag_i );
+    frag_i = i + 1;
+
+    if ( byte == parser->eol && parser->line_len > 0
+        && _line_end( parser ) ) {
+      parser->stopped = true;
+      return i + 1;
+    }
+  }
+
+  _data_emit( parser, &bytes[ frag_i ], len - frag_i );
+
+  return len;
+}
+
+bool at_parser_code_from_str( bool verbose, const char *str, at_code_t *code ) {
+  return at_code_lookup( str, strlen( str ), verbose, code );
+}
@@ -6,10 +6,15 @@
 #include <zephyr/drivers/uart.h>
 #include <zephyr/logging/log.h>
 
+#ifdef CONFIG_AT_UART_FAST_START
+#include <zephyr/settings/settings.h>
+#endif
+
 #include "stru.h"
 
 #include "at.h"
 #include "at_uart.h"
+#include "at_parser.h"
 
 LOG_MODULE_REGISTER( at_uart );
 
@@ -22,6 +27,34 @@ LOG_MODULE_REGISTER( at_uart );
 // Default AT short response timeout
 #define AT_SHORT_TIMEOUT          1000 // ms
 
+// Time given to the DCE to switch its baudrate after answering AT+IPR
+#define AT_IPR_SETTLE_TIME        50 // ms
+
+// Time given to a partially received URC to be completed before a command is written
+#define AT_URC_SETTLE_TIME        100 // ms
+
+// Baudrates accepted by AT+IPR, the index of each baudrate
+// is the value expected by the command (Iridium 9602/9603 numbering)
+static const uint32_t g_ipr_baudrates[] = {
+  0, 600, 1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200
+};
+
+/**
+ * @brief Returns the earliest of the given deadline and the instance deadline
+ */
+static inline k_timepoint_t _deadline_clamp( at_uart_t *at_uart, k_timepoint_t deadline ) {
+  return sys_timepoint_cmp( deadline, at_uart->deadline ) < 0
+    ? deadline : at_uart->deadline;
+}
+
+/**
+ * @brief Computes a deadline from now, clamped to the instance deadline
+ */
+static inline k_timepoint_t _deadline_calc( at_uart_t *at_uart, uint32_t timeout_ms ) {
+  return _deadline_clamp( 
+    at_uart, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
 // ------------- Private AT basic commands ---------------
 
 /**
@@ -72,8 +105,284 @@ static at_uart_err_t _at_uart_enable_echo( at_uart_t *at_uart, bool enable );
 
 static at_uart_err_t _at_uart_three_wire_connection( at_uart_t *at_uart, bool using );
 
+/**
+ * @brief Applies the whole basic configuration using two command lines 
+ * instead of one command per setting, see at_uart_config_t
+ * 
+ * @param three_wire Disables flow control and DTR
+ * @return at_uart_err_t Result of the flow control and DTR line
+ */
+static at_uart_err_t _at_uart_batch_setup( at_uart_t *at_uart, bool three_wire );
+
+/**
+ * @brief Applies flow control and DTR settings using a single command line
+ * 
+ * @param three_wire Disables flow control and DTR
+ */
+static at_uart_err_t _at_uart_batch_three_wire( at_uart_t *at_uart, bool three_wire );
+
+#ifdef CONFIG_AT_UART_FAST_START
+// increase if the fingerprint layout or the configuration sequence changes
+#define AT_PROFILE_VERSION        1
+
+// settings key prefix, the name of the UART device is appended
+#define AT_PROFILE_KEY_PREFIX     "at_uart/"
+#define AT_PROFILE_KEY_SIZE       48
+
+/**
+ * @brief Builds the settings key of the fingerprint, one per UART device
+ */
+static void _profile_key( at_uart_t *at_uart, char *key, size_t key_size );
+
+/**
+ * @brief Computes a fingerprint of the configuration applied to the modem 
+ */
+static uint32_t _profile_fingerprint( at_uart_t *at_uart, bool three_wire );
+
+/**
+ * @brief Retrieves the fingerprint of the configuration stored in the modem
+ * 
+ * @return uint32_t 0 if there is no stored fingerprint
+ */
+static uint32_t _profile_load( at_uart_t *at_uart );
+
+/**
+ * @brief Stores the active configuration in the modem profile
+ * and the given fingerprint in the settings subsystem
+ */
+static at_uart_err_t _profile_store( at_uart_t *at_uart, uint32_t fingerprint );
+#endif
+
+/**
+ * @brief Applies the whole basic configuration using the current baudrate,
+ * see at_uart_config_t
+ * 
+ * @param three_wire Disables flow control and DTR
+ */
+static at_uart_err_t _at_uart_configure( at_uart_t *at_uart, bool three_wire );
+
+/**
+ * @brief Checks that the DCE answers to a basic AT command
+ * using the current baudrate
+ * 
+ * @return at_uart_err_t 
+ */
+static at_uart_err_t _at_uart_probe( at_uart_t *at_uart );
+
+/**
+ * @brief Retrieves the AT+IPR value of the given baudrate
+ * 
+ * @return uint8_t 0 if the baudrate is not supported
+ */
+static uint8_t _ipr_from_baudrate( uint32_t baudrate );
+
+/**
+ * @brief Feeds pending received lines into the URC parser, so URCs are
+ * dispatched and any other line is dropped
+ */
+static void _urc_flush( at_uart_t *at_uart );
+
 // --------- End of private AT basic commands ------------
 
+/**
+ * @brief State of a response being parsed by at_uart_parse_resp()
+ */
+typedef struct at_resp_state {
+  at_uart_t *at_uart;
+  char *buf; // output buffer
+  uint16_t buf_size; // output buffer size
+  uint16_t buf_i; // buffer current index
+  uint16_t buf_li; // buffer last line end index
+  uint8_t lines; // expected lines
+  uint8_t line_n; // current line number
+  at_uart_err_t ret; // resulting code, valid once the parser has been stopped
+} at_resp_state_t;
+
+/**
+ * @brief Maps final result codes to AT UART errors
+ */
+static inline at_uart_err_t _code_to_err( at_code_t code ) {
+  return code == AT_CODE_OK ? AT_UART_OK : AT_UART_ERR;
+}
+
+/**
+ * @brief Checks if the given result code finishes a response
+ * 
+ * @note Numeric codes other than OK and ERROR are not distinguishable from command
+ * specific numeric values (for example +SBDWB or +SBDD status), so they
+ * are treated as information lines
+ */
+static inline bool _code_is_resp_end( at_uart_t *at_uart, at_code_t code ) {
+  return at_code_is_final( code ) 
+    && ( at_uart->config.verbose || code == AT_CODE_OK || code == AT_CODE_ERROR );
+}
+
+/**
+ * @brief Delivers an unsolicited result code to the registered handler
+ */
+static inline void _urc_dispatch( at_uart_t *at_uart, const at_parser_evt_t *evt ) {
+  
+  LOG_DBG( "URC ~ %s", evt->data );
+
+  if ( at_uart->urc_cb ) {
+    at_uart->urc_cb( at_uart, evt->data, evt->len, at_uart->urc_user_data );
+  }
+}
+
+/**
+ * @brief Initializes a parser using the current instance configuration
+ */
+static inline void _parser_init( 
+  at_uart_t *at_uart, at_parser_t *parser, at_parser_cb_t cb, void *user_data 
+) {
+  at_parser_init( parser, at_uart->config.verbose, cb, user_data );
+  at_parser_set_urcs( parser, at_uart->urcs, at_uart->n_urcs );
+}
+
+/**
+ * @brief Appends a char to the response buffer, exceeding chars are only counted
+ * in order to detect overflows
+ */
+static inline void _resp_put( at_resp_state_t *resp, char c ) {
+  if ( resp->buf ) {
+    if ( resp->buf_i < resp->buf_size - 1 ) {
+      resp->buf[ resp->buf_i ] = c;
+      resp->buf[ resp->buf_i + 1 ] = '\0';
+    }
+    resp->buf_i++;
+  }
+}
+
+/**
+ * @brief Parser token handler used by at_uart_parse_resp()
+ */
+static bool _resp_tok_handler( 
+  at_parser_t *parser, const at_parser_evt_t *evt, void *user_data 
+) {
+
+  at_resp_state_t *resp = user_data;
+
+  if ( evt->tok == AT_PARSER_TOK_DATA ) {
+    for ( uint16_t i = 0; i < evt->len; i++ ) {
+      _resp_put( resp, evt->data[ i ] );
+    }
+    return false;
+  }
+
+  if ( evt->tok == AT_PARSER_TOK_URC ) {
+    
+    // the URC line is removed from the response, the separator
+    // written after the previous line (if any) is kept
+    uint16_t line_start = resp->line_n > 1 
+      ? resp->buf_li + 1 
+      : resp->buf_li;
+
+    resp->buf_i = line_start;
+    
+    if ( resp->buf && line_start < resp->buf_size ) {
+      resp->buf[ line_start ] = '\0';
+    }
+
+    _urc_dispatch( resp->at_uart, evt );
+    return false;
+  }
+
+  if ( evt->tok == AT_PARSER_TOK_CODE ) {
+    resp->at_uart->code = evt->code;
+  }
+
+  if ( evt->tok == AT_PARSER_TOK_CODE
+      && _code_is_resp_end( resp->at_uart, evt->code )
+      && ( resp->lines == AT_UNK_LINE_RESP 
+        || resp->line_n == resp->lines
+        || resp->line_n == 1 ) ) {
+
+    resp->ret = _code_to_err( evt->code );
+
+    // result code line is removed from the response
+    if ( resp->buf ) {
+      if ( resp->buf_li >= resp->buf_size ) {
+        resp->ret = AT_UART_OVERFLOW;
+      } else {
+        resp->buf[ resp->buf_li ] = '\0';
+      }
+    }
+
+    return true;
+  }
+
+  resp->line_n++;
+
+  // TODO: recheck this
+  if ( resp->lines > 0 && resp->line_n > resp->lines ) {
+
+    if ( resp->buf && resp->buf_i > resp->buf_size ) {
+      resp->ret = AT_UART_OVERFLOW;
+    } else {
+      resp->ret = AT_UART_UNK;
+    }
+
+    return true;
+  }
+
+  resp->buf_li = resp->buf_i;
+
+  // this char is used to split multiline responses
+  _resp_put( resp, '\n' );
+
+  return false;
+}
+
+
+/**
+ * @brief Retrieves the next span of received bytes. Spans are accessed 
+ * in place when zero-copy reception is supported, otherwise 
+ * line chunks are read into the given auxiliary buffer
+ */
+static uint32_t _rx_span_get( 
+  at_uart_t *at_uart, uint8_t **data, 
+  uint8_t *chunk, uint16_t chunk_size, k_timepoint_t deadline 
+) {
+
+  if ( zuart_rx_claim_supported( &at_uart->zuart ) ) {
+    return zuart_rx_claim_deadline( 
+      &at_uart->zuart, data, at_uart->zuart.config.rx_buf_size, deadline );
+  }
+
+  // line chunks are read in bulk, every chunk finishes with a trailing
+  // char (if found) so no bytes are consumed beyond the final result code
+  *data = chunk;
+  
+  return zuart_read_until_deadline( 
+    &at_uart->zuart, chunk, chunk_size, "\r\n", deadline );
+}
+
+/**
+ * @brief Consumes the given number of bytes from the last retrieved span
+ */
+static void _rx_span_done( at_uart_t *at_uart, uint32_t n_bytes ) {
+  if ( zuart_rx_claim_supported( &at_uart->zuart ) ) {
+    zuart_rx_finish( &at_uart->zuart, n_bytes );
+  }
+}
+
+/**
+ * @brief Feeds a byte received before the echo into the URC parser, 
+ * unless it is the expected first byte of the echo
+ * 
+ * @return true The byte has been fed
+ */
+static bool _echo_lead_byte( at_uart_t *at_uart, uint8_t byte ) {
+
+  if ( at_uart->urc_parser.line_len == 0 && byte == at_uart->tx_shadow[ 0 ] ) {
+    return false;
+  }
+
+  // completed lines stop the parser, URCs are dispatched
+  at_parser_feed( &at_uart->urc_parser, &byte, 1 );
+
+  return true;
+}
 
 at_uart_err_t at_uart_check_echo( at_uart_t *at_uart ) {
 
@@ -81,39 +390,65 @@ at_uart_err_t at_uart_check_echo( at_uart_t *at_uart ) {
     return AT_UART_OK;
   }
 
-  uint8_t byte;
-  // uint16_t byte_i = 0;
-
   // This flag is used to avoid rechecking echo for segmented responses
   at_uart->_echoed = true;
 
-  at_uart_err_t at_code = AT_UART_OK;
+  uint8_t chunk[ AT_MIN_BUFF_SIZE ];
+  uint8_t *data;
+  uint32_t data_len;
+  uint16_t echo_i = 0;
 
-  while( zuart_read( &at_uart->zuart, &byte, 1, AT_SHORT_TIMEOUT ) == 1 ) {
+  uint16_t shadow_len = MIN( at_uart->tx_len, sizeof( at_uart->tx_shadow ) );
 
-    // if ( byte_i == 0 && byte == '\n' ) continue;
+  // ! Echoed bytes are compared as they arrive, so a corrupted command
+  // ! (electrical noise, long/unconnected wires) is detected with the first
+  // ! mismatching byte instead of waiting for a random \r char or the timeout
+  k_timepoint_t deadline = _deadline_calc( at_uart, AT_SHORT_TIMEOUT );
 
-    // ! When a mismatch is detected we have to drop all remaining chars
-    // ! In case of electrical noise, the trailing char may be different
-    // ! and not detected, in that case a timeout error will be returned
-    // ! In case of extreme electrical noise (long/unconnected wires) 
-    // ! this loop could get stuck until \r char is randomly found
-    // TODO: Illegal private access, create a function inside zuart module
-    // TODO: to retrieve specific transmission byte
+  while ( ( data_len = _rx_span_get( 
+      at_uart, &data, chunk, sizeof( chunk ), deadline ) ) > 0 ) {
 
-    // ! If we want to check echo like this we need an additional buffer
-    // ! to store the transmitted command, otherwise we can skip the command completely
-    // if ( at_uart->zuart.buf.tx[ byte_i ] != byte ) {
-    //   // Echoed command do not matches previously transmitted command
-    //   at_code = AT_UART_ERR;
-    // }
+    for ( uint32_t i = 0; i < data_len; i++ ) {
 
-    // byte_i++;
+      if ( echo_i == 0 && _echo_lead_byte( at_uart, data[ i ] ) ) {
+
+        // ! Bytes received ahead of the echo (for example an URC which
+        // ! arrived while the command was being sent) go through the URC
+        // ! parser, the echo comparison restarts after them
+        if ( at_uart->urc_parser.line_len == 0 
+            || at_parser_urc_possible( &at_uart->urc_parser ) ) {
+          continue;
+        }
+
+        // not an URC, so the first echoed byte was corrupted
+        at_parser_reset( &at_uart->urc_parser );
+      }
+
+      if ( echo_i >= at_uart->tx_len
+          || ( echo_i < shadow_len && data[ i ] != at_uart->tx_shadow[ echo_i ] ) ) {
+        
+        LOG_WRN( "Echo mismatch at %u", echo_i );
+        
+        // the response of a corrupted command is meaningless,
+        // but URCs received along with it are still dispatched
+        _rx_span_done( at_uart, i + 1 );
+        _urc_flush( at_uart );
+
+        return AT_UART_ECHO;
+      }
 
-    if ( byte == '\r' ) {
-      return at_code;
+      if ( data[ i ] == '\r' ) {
+        
+        // only the echo is consumed, response bytes are kept
+        _rx_span_done( at_uart, i + 1 );
+
+        return echo_i + 1 == at_uart->tx_len ? AT_UART_OK : AT_UART_ECHO;
+      }
+
+      echo_i++;
     }
 
+    _rx_span_done( at_uart, data_len );
   }
 
   return AT_UART_TIMEOUT;
@@ -125,91 +460,249 @@ at_uart_err_t at_uart_parse_resp(
   char *buf, uint16_t buf_size, 
   uint8_t lines, uint16_t timeout_ms
 ) {
-  
-  uint8_t line_n = 1; // current line number
+  return at_uart_parse_resp_deadline( 
+    at_uart, buf, buf_size, lines, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
 
-  uint16_t buf_i = 0; // buffer current index
-  uint16_t buf_li = 0; // buffer last line end index
-  uint16_t at_buf_i = 0; // auxiliary buffer index
+at_uart_err_t at_uart_parse_resp_deadline(
+  at_uart_t *at_uart, 
+  char *buf, uint16_t buf_size, 
+  uint8_t lines, k_timepoint_t deadline
+) {
 
-  // this little buffer is used to parse AT status codes like ERROR, OK, ...
-  char at_buf[ AT_MIN_BUFF_SIZE ] = "";
+  at_resp_state_t resp = {
+    .at_uart = at_uart,
+    .buf = buf,
+    .buf_size = buf_size,
+    .lines = lines,
+    .line_n = 1,
+  };
 
-  unsigned char byte;
+  at_uart->code = AT_CODE_NONE;
 
-  while ( zuart_read( &at_uart->zuart, &byte, 1, timeout_ms ) == 1 ) {
-    
-    // Used to add or not the current byte to the output buffer
-    unsigned char add_char = byte;
+  at_parser_t parser;
+  _parser_init( at_uart, &parser, _resp_tok_handler, &resp );
 
-    // Used to know if the current char is a trailing char or not
-    // Also known as EOL (end of line) 
-    unsigned char trail_char = 0;
-    
-    if ( byte == '\r' || byte == '\n' ) {
-      add_char = 0;
-      trail_char = byte;
-    }
+  // the whole response is bounded, so a trickle of 
+  // received bytes can not extend the wait
+  at_uart_err_t ret = at_uart_pump( at_uart, &parser, deadline );
 
-    if ( at_buf_i > 0 && trail_char == at_uart->eol ) { // new line detected
-      
-      if ( lines == AT_UNK_LINE_RESP 
-          || line_n == lines
-          || line_n == 1 ) {
-        
-        at_uart_err_t at_code = at_uart_get_str_code( at_uart, at_buf );
-
-        if ( at_code != AT_UART_UNK ) {
-          
-          if ( buf ) {
-            if ( buf_li >= buf_size ) {
-              return AT_UART_OVERFLOW;
-            } else {
-              buf[ buf_li ] = '\0';
-            }
-          }
-          
-          return at_code;
-        }
-      }
+  return ret == AT_UART_OK ? resp.ret : ret;
+}
 
-      line_n++;
-      
-       // TODO: recheck this
-      if ( lines > 0 && line_n > lines ) {
+/**
+ * @brief State of a response being streamed by at_uart_stream_resp()
+ */
+typedef struct at_stream_state {
+  at_uart_t *at_uart;
+  at_uart_resp_cb_t cb;
+  void *user_data;
+  bool flushed; // the held beginning of the current line has been delivered
+  uint8_t lines; // expected lines
+  uint8_t line_n; // current line number
+  at_uart_err_t ret; // resulting code, valid once the parser has been stopped
+} at_stream_state_t;
 
-        if ( buf && buf_i > buf_size ) {
-          return AT_UART_OVERFLOW;
-        } else {
-          return AT_UART_UNK;
-        }
+/**
+ * @brief Parser token handler used by at_uart_stream_resp()
+ */
+static bool _stream_tok_handler( 
+  at_parser_t *parser, const at_parser_evt_t *evt, void *user_data 
+) {
 
-      }
+  at_stream_state_t *stream = user_data;
+  at_uart_t *at_uart = stream->at_uart;
 
-      buf_li = buf_i;
+  if ( evt->tok == AT_PARSER_TOK_DATA ) {
 
-      at_buf_i = 0;
-      at_buf[ 0 ] = '\0';
+    uint16_t held = sizeof( parser->hold ) - 1;
 
-      // this char is used to split multiline responses
-      add_char = '\n';
+    // ! While the line fits the parser hold buffer it could still be 
+    // ! a result code, it is delivered once the line is completed
+    if ( parser->line_len <= held || at_parser_urc_possible( parser ) ) {
+      return false;
     }
 
-    if ( buf && add_char ) {
-      if ( buf_i < buf_size - 1 ) {
-        buf[ buf_i ] = add_char;
-        buf[ buf_i + 1 ] = '\0';
-      }
-      buf_i++;
+    if ( !stream->flushed ) {
+      stream->cb( at_uart, parser->hold, held, false, stream->user_data );
+      stream->flushed = true;
     }
 
-    // at buff is only used for AT command responses
-    if ( !trail_char && at_buf_i < sizeof( at_buf ) - 1 ) {
-      at_buf[ at_buf_i ] = byte;
-      at_buf[ at_buf_i + 1 ] = '\0';
-      at_buf_i++;
-    }
+    // skip the part of this fragment which was already held
+    uint16_t prev_len = parser->line_len - evt->len;
+    uint16_t skip = prev_len < held ? held - prev_len : 0;
+
+    stream->cb( at_uart, evt->data + skip, evt->len - skip, false, stream->user_data );
 
+    return false;
+  }
+
+  bool flushed = stream->flushed;
+  stream->flushed = false;
+
+  if ( evt->tok == AT_PARSER_TOK_URC ) {
+    _urc_dispatch( at_uart, evt );
+    return false;
+  }
+
+  if ( evt->tok == AT_PARSER_TOK_CODE ) {
+    at_uart->code = evt->code;
+  }
+
+  if ( evt->tok == AT_PARSER_TOK_CODE
+      && _code_is_resp_end( at_uart, evt->code )
+      && ( stream->lines == AT_UNK_LINE_RESP 
+        || stream->line_n == stream->lines
+        || stream->line_n == 1 ) ) {
+
+    stream->ret = _code_to_err( evt->code );
+    return true;
+  }
+
+  // information line (or intermediate result code), if its beginning
+  // has already been delivered only the line end is notified
+  if ( flushed ) {
+    stream->cb( at_uart, evt->data, 0, true, stream->user_data );
+  } else {
+    stream->cb( at_uart, evt->data, evt->len, true, stream->user_data );
+  }
+
+  stream->line_n++;
+
+  if ( stream->lines > 0 && stream->line_n > stream->lines ) {
+    stream->ret = AT_UART_UNK;
+    return true;
+  }
+
+  return false;
+}
+
+at_uart_err_t at_uart_stream_resp( 
+  at_uart_t *at_uart, at_uart_resp_cb_t cb, void *user_data, 
+  uint8_t lines, uint16_t timeout_ms
+) {
+  return at_uart_stream_resp_deadline( 
+    at_uart, cb, user_data, lines, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
+at_uart_err_t at_uart_stream_resp_deadline( 
+  at_uart_t *at_uart, at_uart_resp_cb_t cb, void *user_data, 
+  uint8_t lines, k_timepoint_t deadline
+) {
+
+  at_stream_state_t stream = {
+    .at_uart = at_uart,
+    .cb = cb,
+    .user_data = user_data,
+    .lines = lines,
+    .line_n = 1,
+  };
+
+  at_uart->code = AT_CODE_NONE;
+
+  at_parser_t parser;
+  _parser_init( at_uart, &parser, _stream_tok_handler, &stream );
+
+  at_uart_err_t ret = at_uart_pump( at_uart, &parser, deadline );
+
+  return ret == AT_UART_OK ? stream.ret : ret;
+}
+
+/**
+ * @brief Parser token handler used by at_uart_wait_urc()
+ */
+static bool _urc_tok_handler( 
+  at_parser_t *parser, const at_parser_evt_t *evt, void *user_data 
+) {
+  
+  at_uart_t *at_uart = user_data;
+
+  if ( evt->tok == AT_PARSER_TOK_DATA ) {
+    return false;
+  }
+
+  if ( evt->tok == AT_PARSER_TOK_URC ) {
+    _urc_dispatch( at_uart, evt );
+    at_uart->urc_ret = AT_UART_OK;
+  } else {
+    at_uart->urc_ret = AT_UART_UNK;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Initializes the parser used to wait for URCs, 
+ * the line being received (if any) is discarded
+ */
+static inline void _urc_parser_init( at_uart_t *at_uart ) {
+  _parser_init( at_uart, &at_uart->urc_parser, _urc_tok_handler, at_uart );
+}
+
+at_uart_err_t at_uart_wait_urc( at_uart_t *at_uart, k_timepoint_t deadline ) {
+
+  at_uart->urc_ret = AT_UART_UNK;
+
+  // ! Bytes fed before the deadline expires are consumed, so the parser state
+  // ! must be kept. Otherwise the tail of a partially received line 
+  // ! would be parsed later as an unknown line and the URC would be lost
+  at_uart_err_t ret = at_uart_pump( at_uart, &at_uart->urc_parser, deadline );
+
+  return ret == AT_UART_OK ? at_uart->urc_ret : ret;
+}
+
+static void _urc_flush( at_uart_t *at_uart ) {
+
+  k_timepoint_t now = sys_timepoint_calc( K_NO_WAIT );
+  k_timepoint_t settle = _deadline_calc( at_uart, AT_URC_SETTLE_TIME );
+
+  do {
+    // every completed line stops the parser
+    while ( at_uart_pump( at_uart, &at_uart->urc_parser, now ) == AT_UART_OK );
+
+    // ! A line which is still being received could be an URC,
+    // ! it is given some time to be completed
+  } while ( at_uart->urc_parser.line_len > 0
+    && at_parser_urc_possible( &at_uart->urc_parser )
+    && at_uart_pump( at_uart, &at_uart->urc_parser, settle ) == AT_UART_OK );
+
+  at_parser_reset( &at_uart->urc_parser );
+}
+
+void at_uart_set_urc_handler( 
+  at_uart_t *at_uart, const char *const *urcs, uint8_t n_urcs,
+  at_uart_urc_cb_t cb, void *user_data 
+) {
+  at_uart->urcs = urcs;
+  at_uart->n_urcs = n_urcs;
+  at_uart->urc_cb = cb;
+  at_uart->urc_user_data = user_data;
+
+  _urc_parser_init( at_uart );
+}
+
+at_uart_err_t at_uart_pump( 
+  at_uart_t *at_uart, at_parser_t *parser, k_timepoint_t deadline 
+) {
+
+  deadline = _deadline_clamp( at_uart, deadline );
+
+  uint8_t *data;
+  uint32_t data_len;
+
+  // only used when zero-copy reception is not supported
+  uint8_t chunk[ AT_MIN_BUFF_SIZE ];
+
+  while ( ( data_len = _rx_span_get( 
+      at_uart, &data, chunk, sizeof( chunk ), deadline ) ) > 0 ) {
+    
+    // remaining bytes are left in the reception buffer
+    // when the parser is stopped
+    _rx_span_done( at_uart, at_parser_feed( parser, data, data_len ) );
+
+    if ( at_parser_stopped( parser ) ) {
+      return AT_UART_OK;
+    }
   }
 
   return AT_UART_TIMEOUT;
@@ -247,9 +740,44 @@ inline at_uart_err_t at_uart_skip_resp(
 at_uart_err_t at_uart_write( 
   at_uart_t *at_uart, const uint8_t *src_buf, uint16_t n_bytes, uint32_t timeout_ms
 ) {
+  return at_uart_write_deadline( 
+    at_uart, src_buf, n_bytes, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
+at_uart_err_t at_uart_write_deadline( 
+  at_uart_t *at_uart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline
+) {
+
+  zuart_iovec_t iov = { .buf = src_buf, .len = n_bytes };
+  
+  return at_uart_writev_deadline( at_uart, &iov, 1, NULL, deadline );
+}
+
+at_uart_err_t at_uart_writev( 
+  at_uart_t *at_uart, const zuart_iovec_t *iov, uint8_t iovcnt, 
+  uint32_t *written, uint32_t timeout_ms
+) {
+  return at_uart_writev_deadline( 
+    at_uart, iov, iovcnt, written, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
+at_uart_err_t at_uart_writev_deadline( 
+  at_uart_t *at_uart, const zuart_iovec_t *iov, uint8_t iovcnt, 
+  uint32_t *written, k_timepoint_t deadline
+) {
+
+  uint32_t n_bytes = 0;
+
+  for ( uint8_t i = 0; i < iovcnt; i++ ) {
+    n_bytes += iov[ i ].len;
+  }
   
-  uint16_t bytes_written = zuart_write( 
-    &at_uart->zuart, src_buf, n_bytes, timeout_ms );
+  uint32_t bytes_written = zuart_writev_deadline( 
+    &at_uart->zuart, iov, iovcnt, _deadline_clamp( at_uart, deadline ) );
+
+  if ( written ) {
+    *written = bytes_written;
+  }
 
   if ( bytes_written < n_bytes ) {
     
@@ -268,9 +796,16 @@ at_uart_err_t at_uart_write(
 at_uart_err_t at_uart_read(
   at_uart_t *at_uart, uint8_t *out_buf, uint16_t n_bytes, uint32_t timeout_ms
 ) {
+  return at_uart_read_deadline( 
+    at_uart, out_buf, n_bytes, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
+at_uart_err_t at_uart_read_deadline(
+  at_uart_t *at_uart, uint8_t *out_buf, uint16_t n_bytes, k_timepoint_t deadline
+) {
 
-  uint16_t bytes_read = zuart_read( 
-    &at_uart->zuart, out_buf, n_bytes, timeout_ms );
+  uint16_t bytes_read = zuart_read_deadline( 
+    &at_uart->zuart, out_buf, n_bytes, _deadline_clamp( at_uart, deadline ) );
 
   if ( bytes_read < n_bytes ) {
     if ( zuart_get_err( &at_uart->zuart ) == ZUART_ERR_TIMEOUT ) {
@@ -283,17 +818,85 @@ at_uart_err_t at_uart_read(
   }
 }
 
+at_uart_err_t at_uart_read_stream_deadline(
+  at_uart_t *at_uart, uint16_t n_bytes, 
+  at_uart_data_cb_t cb, void *user_data, k_timepoint_t deadline
+) {
+
+  uint8_t chunk[ AT_MIN_BUFF_SIZE ];
+  uint8_t *data;
+  uint32_t data_len;
+
+  bool claim = zuart_rx_claim_supported( &at_uart->zuart );
+  
+  deadline = _deadline_clamp( at_uart, deadline );
+
+  while ( n_bytes > 0 ) {
+
+    if ( claim ) {
+      data_len = zuart_rx_claim_deadline( 
+        &at_uart->zuart, &data, n_bytes, deadline );
+    } else {
+      data = chunk;
+      data_len = zuart_read_deadline( 
+        &at_uart->zuart, chunk, MIN( n_bytes, sizeof( chunk ) ), deadline );
+    }
+
+    if ( data_len == 0 ) {
+      return zuart_get_err( &at_uart->zuart ) == ZUART_ERR_TIMEOUT 
+        ? AT_UART_TIMEOUT
+        : AT_UART_ERR;
+    }
+
+    if ( cb ) {
+      cb( at_uart, data, data_len, user_data );
+    }
+
+    if ( claim ) {
+      zuart_rx_finish( &at_uart->zuart, data_len );
+    }
+
+    n_bytes -= data_len;
+  }
+
+  return AT_UART_OK;
+}
+
 at_uart_err_t at_uart_write_cmd( 
-  at_uart_t *at_uart, char *cmd_buf, uint16_t cmd_len
+  at_uart_t *at_uart, const char *cmd_buf, uint16_t cmd_len
+) {
+
+  zuart_iovec_t iov = { .buf = (const uint8_t*) cmd_buf, .len = cmd_len };
+
+  return at_uart_write_cmdv( at_uart, &iov, 1 );
+}
+
+at_uart_err_t at_uart_write_cmdv( 
+  at_uart_t *at_uart, const zuart_iovec_t *iov, uint8_t iovcnt
 ) {
 
   at_uart->_echoed = false;
+  at_uart->tx_len = 0;
+  
+  for ( uint8_t i = 0; i < iovcnt; i++ ) {
+
+    // the echo is compared against the whole command, see at_uart_check_echo()
+    if ( at_uart->tx_len < sizeof( at_uart->tx_shadow ) ) {
+      memcpy( &at_uart->tx_shadow[ at_uart->tx_len ], iov[ i ].buf, 
+        MIN( iov[ i ].len, sizeof( at_uart->tx_shadow ) - at_uart->tx_len ) );
+    }
+
+    at_uart->tx_len += iov[ i ].len;
+
+    LOG_DBG( "~ %.*s", iov[ i ].len, (const char*) iov[ i ].buf );
+  }
   
-  uint32_t purged = zuart_drain( &at_uart->zuart );
-  LOG_DBG( "%u ~ %s", purged, cmd_buf );
+  // ! Pending lines are not simply purged, URCs received since 
+  // ! the last response (ring alerts, indicators, ...) must not be lost
+  _urc_flush( at_uart );
 
-  at_uart_err_t err = at_uart_write(
-    at_uart, cmd_buf, cmd_len, AT_SHORT_TIMEOUT );
+  at_uart_err_t err = at_uart_writev(
+    at_uart, iov, iovcnt, NULL, AT_SHORT_TIMEOUT );
   
   if ( err == AT_UART_OK ) {
     return at_uart_check_echo( at_uart ); 
@@ -303,6 +906,24 @@ at_uart_err_t at_uart_write_cmd(
   
 }
 
+at_uart_err_t at_uart_send_int_cmd(
+  at_uart_t *at_uart, const char *cmd, uint16_t cmd_len, uint32_t value
+) {
+
+  char at_buf[ AT_INT_CMD_BUFF_SIZE ];
+
+  if ( cmd_len + AT_UINT_MAX_DIGITS + AT_CMD_LEN( AT_CMD_EOL_STR ) > sizeof( at_buf ) ) {
+    return AT_UART_OVERFLOW;
+  }
+
+  memcpy( at_buf, cmd, cmd_len );
+  
+  uint16_t len = cmd_len + at_fmt_uint( &at_buf[ cmd_len ], value );
+  at_buf[ len++ ] = AT_CMD_EOL_STR[ 0 ];
+
+  return at_uart_write_cmd( at_uart, at_buf, len );
+}
+
 at_uart_err_t at_uart_send_cmd( 
   at_uart_t *at_uart, 
   char *at_cmd_buf, uint16_t at_cmd_buf_len,
@@ -341,22 +962,84 @@ at_uart_err_t at_uart_send_vcmd(
 
 at_uart_err_t at_uart_get_str_code( at_uart_t *at_uart, const char *buf ) {
 
-  if ( at_uart->config.verbose ) {
-    // ordered by occurrence frequency
-    if ( streq( buf, "OK" ) ) {
-      return AT_UART_OK;
-    } else if ( streq( buf, "ERROR" ) ) {
-      return AT_UART_ERR;
+  at_code_t code;
+
+  if ( at_parser_code_from_str( at_uart->config.verbose, buf, &code ) 
+      && _code_is_resp_end( at_uart, code ) ) {
+    return _code_to_err( code );
+  }
+
+  return AT_UART_UNK;
+}
+
+void at_uart_set_deadline( at_uart_t *at_uart, k_timepoint_t deadline ) {
+  at_uart->deadline = deadline;
+}
+
+static at_uart_err_t _at_uart_configure( at_uart_t *at_uart, bool three_wire ) {
+
+  at_uart_err_t at_code = AT_UART_ERR;
+
+#ifdef CONFIG_AT_UART_FAST_START
+  uint32_t fingerprint = _profile_fingerprint( at_uart, three_wire );
+
+  // ! The modem already boots with the stored profile, a single command line
+  // ! verifies echo and verbose settings (using the expected ones) and 
+  // ! enforces flow control, so a replaced modem can not hang the link
+  bool stored = _profile_load( at_uart ) == fingerprint;
+
+  if ( stored ) {
+    
+    at_code = _at_uart_batch_three_wire( at_uart, three_wire );
+
+    if ( at_code == AT_UART_OK ) {
+      LOG_DBG( "%s", "Using stored modem profile" );
+    } else {
+      stored = false;
     }
-  } else {
-    if ( streq( buf, "0" ) ) {
-      return AT_UART_OK;
-    } else if ( streq( buf, "4" ) ) {
-      return AT_UART_ERR;
+  }
+#endif
+
+  if ( at_code != AT_UART_OK && at_uart->config.batch ) {
+    
+    at_code = _at_uart_batch_setup( at_uart, three_wire );
+
+    if ( at_code != AT_UART_OK ) {
+      LOG_WRN( "Batched setup failed (%s), using individual commands", 
+        at_uart_err_to_name( at_code ) );
     }
   }
 
-  return AT_UART_UNK;
+  if ( at_code != AT_UART_OK ) {
+
+    // ! Disable quiet mode in order to parse command results
+    _at_uart_set_quiet( at_uart, false );
+
+    // ! The response code of this commands
+    // ! are not checked due to the possibility of 
+    // ! an initial conflicting configuration
+    // ! If the result code is an error does not mean
+    // ! that the change has not been applied (only for this specific cases)
+    // ! The last AT test command will finally check if the configuration was
+    // ! correctly applied to the ISU
+    _at_uart_enable_echo( at_uart, at_uart->config.echo );
+    _at_uart_set_verbose( at_uart, at_uart->config.verbose );
+
+    at_code = _at_uart_three_wire_connection( at_uart, three_wire );
+  }
+
+#ifdef CONFIG_AT_UART_FAST_START
+  if ( at_code == AT_UART_OK && !stored ) {
+    
+    // ! The configuration has already been applied, 
+    // ! if it can not be stored the next setup will apply it again
+    if ( _profile_store( at_uart, fingerprint ) != AT_UART_OK ) {
+      LOG_WRN( "%s", "Could not store modem profile" );
+    }
+  }
+#endif
+
+  return at_code;
 }
 
 at_uart_err_t at_uart_setup( 
@@ -366,28 +1049,20 @@ at_uart_err_t at_uart_setup(
   // update whole configuration
   at_uart->config = *at_uart_config;
 
+  at_uart->deadline = sys_timepoint_calc( K_FOREVER );
+
   if ( at_uart->config.verbose ) {
     at_uart->eol = '\n';
   } else {
     at_uart->eol = '\r';
   }
+
+  // depends on the verbose setting
+  _urc_parser_init( at_uart );
   
   // setup underlying uart
   zuart_setup( &at_uart->zuart, &at_uart_config->zuart );
 
-  // ! Disable quiet mode in order to parse command results
-  _at_uart_set_quiet( at_uart, false );
-
-  // ! The response code of this commands
-  // ! are not checked due to the possibility of 
-  // ! an initial conflicting configuration
-  // ! If the result code is an error does not mean
-  // ! that the change has not been applied (only for this specific cases)
-  // ! The last AT test command will finally check if the configuration was
-  // ! correctly applied to the ISU
-  _at_uart_enable_echo( at_uart, at_uart->config.echo );
-  _at_uart_set_verbose( at_uart, at_uart->config.verbose );
-
   // ! Enable or disable flow control depending on uart configuration
   // ! this will avoid hangs during communication
   // ! Remember that the ISU transits between different states
@@ -398,15 +1073,112 @@ at_uart_err_t at_uart_setup(
   
   uart_config_get( at_uart->zuart.dev, &config );
 
-  if ( config.flow_ctrl == UART_CFG_FLOW_CTRL_NONE ) {
-    at_code = _at_uart_three_wire_connection( at_uart, true );
-  } else {
-    at_code = _at_uart_three_wire_connection( at_uart, false );
+  bool three_wire = config.flow_ctrl == UART_CFG_FLOW_CTRL_NONE;
+
+  at_code = _at_uart_configure( at_uart, three_wire );
+
+  // baudrate negotiated by a previous setup, see at_uart_config_t
+  bool negotiated = at_uart->config.baudrate > 0 
+    && at_uart->config.baudrate != config.baudrate;
+
+  if ( at_code != AT_UART_OK && negotiated ) {
+
+    // ! If only the host has been reset the DCE is still using
+    // ! the negotiated baudrate, while the host uses the boot one
+    LOG_WRN( "No answer at %u bauds, trying %u", 
+      config.baudrate, at_uart->config.baudrate );
+
+    if ( zuart_set_baudrate( &at_uart->zuart, at_uart->config.baudrate ) == ZUART_OK ) {
+      
+      at_code = _at_uart_configure( at_uart, three_wire );
+
+      if ( at_code == AT_UART_OK ) {
+        return AT_UART_OK;
+      }
+
+      if ( zuart_set_baudrate( &at_uart->zuart, config.baudrate ) != ZUART_OK ) {
+        LOG_ERR( "Could not restore %u bauds", config.baudrate );
+      }
+    }
+  }
+
+  if ( at_code == AT_UART_OK && negotiated ) {
+    
+    // ! A failed negotiation is not fatal, the link
+    // ! falls back to the previous baudrate
+    if ( at_uart_set_baudrate( at_uart, at_uart->config.baudrate ) != AT_UART_OK ) {
+      
+      LOG_WRN( "Could not switch to %u bauds, using %u", 
+        at_uart->config.baudrate, config.baudrate );
+      
+      at_code = _at_uart_probe( at_uart );
+    }
   }
 
   return at_code; 
 }
 
+at_uart_err_t at_uart_set_baudrate( at_uart_t *at_uart, uint32_t baudrate ) {
+  
+  struct uart_config config;
+
+  uint8_t ipr = _ipr_from_baudrate( baudrate );
+
+  if ( ipr == 0 || uart_config_get( at_uart->zuart.dev, &config ) != 0 ) {
+    return AT_UART_ERR;
+  }
+
+  uint32_t old_baudrate = config.baudrate;
+
+  if ( old_baudrate == baudrate ) {
+    return AT_UART_OK;
+  }
+
+  at_uart_err_t ret;
+  AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, "+ipr=", ipr );
+
+  ret = at_uart_skip_resp( 
+    at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
+
+  AT_UART_RET_IF_ERR( ret );
+
+  // the result code is sent using the old baudrate,
+  // the DCE switches right after that
+  k_msleep( AT_IPR_SETTLE_TIME );
+
+  if ( zuart_set_baudrate( &at_uart->zuart, baudrate ) != ZUART_OK ) {
+    return AT_UART_ERR;
+  }
+
+  ret = _at_uart_probe( at_uart );
+
+  if ( ret == AT_UART_OK ) {
+    LOG_DBG( "Switched to %u bauds", baudrate );
+    return AT_UART_OK;
+  }
+
+  // ! The link is not reliable using the new baudrate, the DCE is asked
+  // ! (blindly) to go back to the previous baudrate. If the previous
+  // ! baudrate can not be requested, only the host side is restored
+  uint8_t old_ipr = _ipr_from_baudrate( old_baudrate );
+
+  if ( old_ipr > 0 ) {
+    at_uart_send_int_cmd( 
+      at_uart, AT_STR "+ipr=", AT_CMD_LEN( AT_STR "+ipr=" ), old_ipr );
+    k_msleep( AT_IPR_SETTLE_TIME );
+  }
+
+  if ( zuart_set_baudrate( &at_uart->zuart, old_baudrate ) != ZUART_OK ) {
+    LOG_ERR( "Could not restore %u bauds", old_baudrate );
+    return AT_UART_ERR;
+  }
+
+  ret = _at_uart_probe( at_uart );
+
+  // the baudrate has not been applied even if the link was recovered
+  return ret == AT_UART_OK ? AT_UART_ERR : ret;
+}
+
 const char *at_uart_err_to_name( at_uart_err_t code ) {
   
   if ( code == AT_UART_OK ) {
@@ -417,17 +1189,26 @@ const char *at_uart_err_to_name( at_uart_err_t code ) {
     return "AT_UART_OVERFLOW";
   } else if ( code == AT_UART_TIMEOUT ) {
     return "AT_UART_TIMEOUT";
+  } else if ( code == AT_UART_ECHO ) {
+    return "AT_UART_ECHO";
   }
 
   return "AT_UART_UNKNOWN";
 }
 
+void at_uart_profile_invalidate( at_uart_t *at_uart ) {
+#ifdef CONFIG_AT_UART_FAST_START
+  char key[ AT_PROFILE_KEY_SIZE ];
+
+  _profile_key( at_uart, key, sizeof( key ) );
+  settings_delete( key );
+#endif
+}
+
 // ------ Non proprietary AT basic commands implementation ------
 at_uart_err_t at_uart_set_flow_control( at_uart_t *at_uart, uint8_t option ) {
-  // AT_UART_SEND_OR_RET( at_uart, AT_CMD_TMPL_EXEC_INT, "&k", option );
   at_uart_err_t ret;
-  AT_UART_SEND_TINY_CMD_OR_RET( 
-    ret, at_uart, AT_CMD_TMPL_EXEC_INT, "&k", option );
+  AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, "&k", option );
 
   return at_uart_skip_resp( 
     at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
@@ -436,8 +1217,7 @@ at_uart_err_t at_uart_set_flow_control( at_uart_t *at_uart, uint8_t option ) {
 at_uart_err_t at_uart_set_dtr( at_uart_t *at_uart, uint8_t option ) {
   
   at_uart_err_t ret;
-  AT_UART_SEND_TINY_CMD_OR_RET( 
-    ret, at_uart, AT_CMD_TMPL_EXEC_INT, "&d", option );
+  AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, "&d", option );
 
   return at_uart_skip_resp( 
     at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
@@ -446,8 +1226,7 @@ at_uart_err_t at_uart_set_dtr( at_uart_t *at_uart, uint8_t option ) {
 at_uart_err_t at_uart_store_active_config( at_uart_t *at_uart, uint8_t profile ) {
   
   at_uart_err_t ret; 
-  AT_UART_SEND_TINY_CMD_OR_RET( 
-    ret, at_uart, AT_CMD_TMPL_EXEC_INT, "&w", profile );
+  AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, "&w", profile );
 
   return at_uart_skip_resp( 
     at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
@@ -456,8 +1235,7 @@ at_uart_err_t at_uart_store_active_config( at_uart_t *at_uart, uint8_t profile )
 at_uart_err_t at_uart_set_reset_profile( at_uart_t *at_uart, uint8_t profile ) {
   
   at_uart_err_t ret; 
-  AT_UART_SEND_TINY_CMD_OR_RET( 
-    ret, at_uart, AT_CMD_TMPL_EXEC_INT, "&y", profile );
+  AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, "&y", profile );
 
   return at_uart_skip_resp( 
     at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
@@ -466,8 +1244,7 @@ at_uart_err_t at_uart_set_reset_profile( at_uart_t *at_uart, uint8_t profile ) {
 at_uart_err_t at_uart_flush_to_eeprom( at_uart_t *at_uart ) {
 
   at_uart_err_t ret;
-  AT_UART_SEND_TINY_CMD_OR_RET( 
-    ret, at_uart, AT_CMD_TMPL_EXEC, "*f" );
+  AT_UART_SEND_CONST_CMD_OR_RET( ret, at_uart, "*f" );
 
   return at_uart_skip_resp( 
     at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
@@ -480,8 +1257,7 @@ at_uart_err_t at_uart_flush_to_eeprom( at_uart_t *at_uart ) {
 static at_uart_err_t _at_uart_set_quiet( at_uart_t *at_uart, bool enable ) {
 
   at_uart_err_t ret;
-  AT_UART_SEND_TINY_CMD_OR_RET( 
-    ret, at_uart, AT_CMD_TMPL_EXEC_INT, "q", enable );
+  AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, "q", enable );
 
   return at_uart_skip_resp( 
     at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
@@ -492,8 +1268,7 @@ static at_uart_err_t _at_uart_enable_echo( at_uart_t *at_uart, bool enable ) {
   at_uart_err_t ret;
   at_uart->config.echo = enable;
 
-  AT_UART_SEND_TINY_CMD_OR_RET( 
-    ret, at_uart, AT_CMD_TMPL_EXEC_INT, "e", enable );
+  AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, "e", enable );
   
   return at_uart_skip_resp( 
     at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
@@ -504,8 +1279,7 @@ static at_uart_err_t _at_uart_set_verbose( at_uart_t *at_uart, bool enable ) {
   at_uart_err_t ret;
   at_uart->config.verbose = enable;
   
-  AT_UART_SEND_TINY_CMD_OR_RET( 
-    ret, at_uart, AT_CMD_TMPL_EXEC_INT, "v", enable );
+  AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, "v", enable );
   
   return at_uart_skip_resp( 
     at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
@@ -525,4 +1299,147 @@ static at_uart_err_t _at_uart_three_wire_connection( at_uart_t *at_uart, bool us
   return ret;
 }
 
+static uint16_t _cmd_append_int( 
+  char *cmd, uint16_t len, const char *param, uint32_t value 
+) {
+
+  while ( *param ) {
+    cmd[ len++ ] = *param++;
+  }
+
+  return len + at_fmt_uint( &cmd[ len ], value );
+}
+
+static at_uart_err_t _at_uart_batch_setup( at_uart_t *at_uart, bool three_wire ) {
+
+  char cmd[ AT_INT_CMD_BUFF_SIZE ];
+  uint16_t len;
+
+  // ! The echo and format of the response to this line depend on the 
+  // ! previous configuration, which is unknown, so as in the individual 
+  // ! sequence its result is not checked. E and V are applied in the same line
+  memcpy( cmd, AT_STR, AT_CMD_LEN( AT_STR ) );
+
+  len = _cmd_append_int( cmd, AT_CMD_LEN( AT_STR ), "q", 0 );
+  len = _cmd_append_int( cmd, len, "e", at_uart->config.echo );
+  len = _cmd_append_int( cmd, len, "v", at_uart->config.verbose );
+  cmd[ len++ ] = AT_CMD_EOL_STR[ 0 ];
+
+  if ( at_uart_write_cmd( at_uart, cmd, len ) == AT_UART_OK ) {
+    at_uart_skip_resp( at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
+  }
+
+  // from now on the configuration is known, this line is checked
+  return _at_uart_batch_three_wire( at_uart, three_wire );
+}
+
+static at_uart_err_t _at_uart_batch_three_wire( at_uart_t *at_uart, bool three_wire ) {
+
+  at_uart_err_t ret;
+  char cmd[ AT_INT_CMD_BUFF_SIZE ];
+  uint16_t len;
+  uint8_t en_param = three_wire ? 0 : 3;
+
+  memcpy( cmd, AT_STR, AT_CMD_LEN( AT_STR ) );
+
+  len = _cmd_append_int( cmd, AT_CMD_LEN( AT_STR ), "&k", en_param );
+  len = _cmd_append_int( cmd, len, "&d", en_param );
+  cmd[ len++ ] = AT_CMD_EOL_STR[ 0 ];
+
+  ret = at_uart_write_cmd( at_uart, cmd, len );
+  AT_UART_RET_IF_ERR( ret );
+
+  return at_uart_skip_resp( 
+    at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
+}
+
+#ifdef CONFIG_AT_UART_FAST_START
+static void _profile_key( at_uart_t *at_uart, char *key, size_t key_size ) {
+  snprintf( key, key_size, AT_PROFILE_KEY_PREFIX "%s", at_uart->zuart.dev->name );
+}
+
+static uint32_t _profile_fingerprint( at_uart_t *at_uart, bool three_wire ) {
+  return ( AT_PROFILE_VERSION << 16 )
+    | ( CONFIG_AT_UART_FAST_START_PROFILE << 8 )
+    | ( three_wire << 2 )
+    | ( at_uart->config.verbose << 1 )
+    | ( at_uart->config.echo << 0 );
+}
+
+static int _profile_load_cb( 
+  const char *key, size_t len, settings_read_cb read_cb, void *cb_arg, void *param 
+) {
+
+  // only the exact key is accepted, not its descendants
+  if ( key == NULL && len == sizeof( uint32_t ) ) {
+    if ( read_cb( cb_arg, param, len ) != (ssize_t) len ) {
+      *( (uint32_t*) param ) = 0;
+    }
+  }
+
+  return 0;
+}
+
+static uint32_t _profile_load( at_uart_t *at_uart ) {
+
+  char key[ AT_PROFILE_KEY_SIZE ];
+  uint32_t fingerprint = 0;
+
+  _profile_key( at_uart, key, sizeof( key ) );
+
+  if ( settings_subsys_init() == 0 ) {
+    settings_load_subtree_direct( key, _profile_load_cb, &fingerprint );
+  }
+
+  return fingerprint;
+}
+
+static at_uart_err_t _profile_store( at_uart_t *at_uart, uint32_t fingerprint ) {
+
+  char key[ AT_PROFILE_KEY_SIZE ];
+
+  at_uart_err_t ret = at_uart_store_active_config( 
+    at_uart, CONFIG_AT_UART_FAST_START_PROFILE );
+
+  if ( ret == AT_UART_OK ) {
+    ret = at_uart_set_reset_profile( 
+      at_uart, CONFIG_AT_UART_FAST_START_PROFILE );
+  }
+
+  AT_UART_RET_IF_ERR( ret );
+
+  _profile_key( at_uart, key, sizeof( key ) );
+
+  if ( settings_save_one( key, &fingerprint, sizeof( fingerprint ) ) != 0 ) {
+    return AT_UART_ERR;
+  }
+
+  return AT_UART_OK;
+}
+#endif
+
+static at_uart_err_t _at_uart_probe( at_uart_t *at_uart ) {
+
+  at_uart_err_t ret;
+
+  // remaining bytes may have been received using a different baudrate
+  zuart_drain( &at_uart->zuart );
+
+  AT_UART_SEND_CONST_CMD_OR_RET( ret, at_uart, "" );
+
+  return at_uart_skip_resp( 
+    at_uart, AT_1_LINE_RESP, AT_SHORT_TIMEOUT );
+}
+
+static uint8_t _ipr_from_baudrate( uint32_t baudrate ) {
+  
+  for ( uint8_t i = 1; i < ARRAY_SIZE( g_ipr_baudrates ); i++ ) {
+    if ( g_ipr_baudrates[ i ] == baudrate ) {
+      return i;
+    }
+  }
+
+  return 0;
+}
+
 // -------------------------------------------------------------
\ No newline at end of file
@@ -4,6 +4,7 @@
   #include <stdio.h>
   #include <string.h>
   #include <stdint.h>
+  #include <stdbool.h>
 
   #define AT_MAX_CMD_LEN    255
   #define AT_MAX_CMD_SIZE   (AT_MAX_CMD_LEN + 1)
@@ -25,4 +26,90 @@
   #define AT_CMD_TMPL_SET_INT   GEN_AT_CMD_TMPL( "=%d" )
   #define AT_CMD_TMPL_SET_STR   GEN_AT_CMD_TMPL( "=%s" )
 
+  /**
+   * @brief Expands to a constant AT command string literal, for example:
+   * AT_CMD( "+CSQ" ) -> "at+CSQ\r". No formatting is required at runtime
+   */
+  #define AT_CMD( cmd )         AT_STR cmd AT_CMD_EOL_STR
+
+  /**
+   * @brief Length of a string literal computed at compile time
+   */
+  #define AT_CMD_LEN( str )     ( sizeof( str ) - 1 )
+
+  // longest decimal representation of an uint32_t
+  #define AT_UINT_MAX_DIGITS    10
+
+  /**
+   * @brief Buffer size used for commands with an integer parameter:
+   * prefix + digits + EOL
+   */
+  #define AT_INT_CMD_BUFF_SIZE  32
+
+  /**
+   * @brief Result codes recognized by the AT parser. Values match 
+   * the numeric form of each code (V.25ter and Iridium specific)
+   */
+  typedef enum at_code {
+    AT_CODE_NONE          = -1, // no result code has been recognized
+    AT_CODE_OK            = 0,
+    AT_CODE_CONNECT       = 1,
+    AT_CODE_RING          = 2,
+    AT_CODE_NO_CARRIER    = 3,
+    AT_CODE_ERROR         = 4,
+    AT_CODE_NO_DIALTONE   = 6,
+    AT_CODE_BUSY          = 7,
+    AT_CODE_NO_ANSWER     = 8,
+    AT_CODE_SBDRING       = 126, // Iridium ring alert
+    AT_CODE_HW_FAILURE    = 127, // Iridium hardware failure
+    AT_CODE_READY, // Iridium intermediate code, only has verbose form
+  } at_code_t;
+
+  /**
+   * @brief Checks if the given code finishes a command response
+   */
+  static inline bool at_code_is_final( at_code_t code ) {
+    switch ( code ) {
+      case AT_CODE_OK:
+      case AT_CODE_CONNECT:
+      case AT_CODE_NO_CARRIER:
+      case AT_CODE_ERROR:
+      case AT_CODE_NO_DIALTONE:
+      case AT_CODE_BUSY:
+      case AT_CODE_NO_ANSWER:
+      case AT_CODE_HW_FAILURE:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /**
+   * @brief Writes the decimal representation of the given value,
+   * without null terminated char. Avoids using the printf family 
+   * for commands with integer parameters
+   * 
+   * @param buf Output buffer, at least AT_UINT_MAX_DIGITS bytes
+   * @param value Value to format
+   * @return uint8_t Number of written chars
+   */
+  uint8_t at_fmt_uint( char *buf, uint32_t value );
+
+  /**
+   * @brief Parses a response line made of a known prefix followed by comma 
+   * separated unsigned fields, for example: "+SBDIX: 0, 12, 1, 3, 120, 0".
+   * Spaces before each field are skipped. Replaces sscanf() for fixed-field responses
+   * 
+   * @param str Null terminated line
+   * @param prefix Expected prefix, for example: "+SBDIX:"
+   * @param fields Output fields
+   * @param max Optional upper bound of each field, UINT16_MAX is used if NULL
+   * @param n_fields Number of fields to parse
+   * @return uint8_t Number of fields parsed before the first mismatch or out of range
+   * field, 0 if the prefix does not match
+   */
+  uint8_t at_parse_uints( 
+    const char *str, const char *prefix, 
+    uint16_t *fields, const uint16_t *max, uint8_t n_fields );
+
 #endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+#ifndef AT_PARSER_H_
+
+  #define AT_PARSER_H_
+
+  #include <stdint.h>
+  #include <stdbool.h>
+
+  #include "at.h"
+
+  // Maximum number of URC prefixes (match mask is 32 bits wide)
+  #define AT_PARSER_MAX_MATCHES   32
+
+  // Size of the buffer used to hold back the beginning of each line,
+  // must fit the longest result code
+  #define AT_PARSER_HOLD_SIZE     32
+
+  typedef enum at_parser_tok {
+    AT_PARSER_TOK_DATA, // fragment of the line being received
+    AT_PARSER_TOK_LINE, // end of an information line
+    AT_PARSER_TOK_CODE, // end of a result code line (final or not, see at_code_is_final())
+    AT_PARSER_TOK_URC, // end of an unsolicited result code line
+  } at_parser_tok_t;
+
+  /**
+   * @brief Token emitted by the parser.
+   * 
+   * @note Line contents are emitted as DATA fragments before the kind 
+   * of the line is known, so consumers which only want information lines 
+   * must discard the fragments of a line ended by a CODE or URC token
+   */
+  typedef struct at_parser_evt {
+    at_parser_tok_t tok;
+
+    // DATA: fragment (not null terminated)
+    // LINE, CODE and URC: null terminated beginning of the line, 
+    // up to AT_PARSER_HOLD_SIZE - 1 chars
+    const char *data;
+    uint16_t len;
+
+    at_code_t code; // AT_CODE_NONE except for CODE tokens
+  } at_parser_evt_t;
+
+  typedef struct at_parser at_parser_t;
+
+  /**
+   * @brief Token handler
+   * 
+   * @return true Feeding must stop right after the current token, 
+   * the return value of DATA tokens is ignored
+   */
+  typedef bool (*at_parser_cb_t)( 
+    at_parser_t *parser, const at_parser_evt_t *evt, void *user_data );
+
+  struct at_parser {
+    bool verbose; // verbose result codes are expected
+    bool stopped; // last feed was stopped by the token handler
+    unsigned char eol; // end of line char
+
+    const char *const *urcs; // URC prefixes
+    uint8_t n_urcs;
+
+    uint16_t line_len; // number of non trailing chars of the current line
+    uint32_t urc_mask; // URC prefixes which still match the current line
+
+    char hold[ AT_PARSER_HOLD_SIZE ]; // beginning of the current line
+
+    at_parser_cb_t cb;
+    void *user_data;
+  };
+
+  /**
+   * @brief Initializes a parser
+   * 
+   * @param verbose Verbose (word like) or numeric result codes are expected
+   * @param cb Token handler
+   * @param user_data Passed to the token handler
+   */
+  void at_parser_init( 
+    at_parser_t *parser, bool verbose, at_parser_cb_t cb, void *user_data );
+
+  /**
+   * @brief Sets the prefixes which identify unsolicited result code lines.
+   * Prefixes ending with ':' (for example "+CIEV:") match any line starting 
+   * with them, other prefixes (for example "SBDRING") must match the whole line
+   * 
+   * @param urcs Null terminated prefixes, must outlive the parser
+   * @param n_urcs Number of prefixes, up to AT_PARSER_MAX_MATCHES
+   */
+  void at_parser_set_urcs( 
+    at_parser_t *parser, const char *const *urcs, uint8_t n_urcs );
+
+  /**
+   * @brief Discards the state of the line being received
+   */
+  void at_parser_reset( at_parser_t *parser );
+
+  /**
+   * @brief Feeds received bytes into the parser. Input can be split at any
+   * point, the state is kept between calls
+   * 
+   * @param bytes Received bytes
+   * @param len Number of received bytes
+   * @return uint32_t Number of consumed bytes, less than len only if the
+   * token handler stopped the parser (see at_parser_stopped())
+   */
+  uint32_t at_parser_feed( at_parser_t *parser, const uint8_t *bytes, uint32_t len );
+
+  /**
+   * @brief Checks if the last feed was stopped by the token handler
+   */
+  static inline bool at_parser_stopped( at_parser_t *parser ) {
+    return parser->stopped;
+  }
+
+  /**
+   * @brief Checks if the line being received could still be an unsolicited
+   * result code, according to the bytes received so far
+   */
+  bool at_parser_urc_possible( at_parser_t *parser );
+
+  /**
+   * @brief Looks up the result code of a line. Lines are dispatched by length 
+   * and first char, so at most a single comparison is done
+   * 
+   * @param str Line (without trailing chars)
+   * @param len Line length
+   * @param verbose Verbose or numeric result codes
+   * @param code Resulting code, AT_CODE_NONE if not found
+   * @return true The line is a result code
+   */
+  bool at_code_lookup( const char *str, uint16_t len, bool verbose, at_code_t *code );
+
+  /**
+   * @brief Looks up the result code of a whole line
+   * 
+   * @param verbose Verbose or numeric result codes
+   * @param str Null terminated line
+   * @param code Resulting code
+   * @return true The line is a result code
+   */
+  bool at_parser_code_from_str( bool verbose, const char *str, at_code_t *code );
+
+#endif
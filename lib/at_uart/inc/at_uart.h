@@ -6,6 +6,7 @@
   #include <stdbool.h>
 
   #include "at.h"
+  #include "at_parser.h"
   #include "zuart.h"
 
   // Expected AT command response lines
@@ -40,6 +41,30 @@
         at_uart, _M_at_buf, sizeof( _M_at_buf ), at_cmd_tmpl, __VA_ARGS__ ); \
     } while (0);
 
+  /**
+   * @brief Used to send a constant command (without parameters or with
+   * literal ones) and return automatically in case of failure. 
+   * The command string and its length are computed at compile time
+   */
+  #define AT_UART_SEND_CONST_CMD_OR_RET( ret, at_uart, cmd ) \
+    do { \
+      ret = at_uart_write_cmd( \
+        at_uart, AT_CMD( cmd ), AT_CMD_LEN( AT_CMD( cmd ) ) ); \
+      AT_UART_RET_IF_ERR( ret ); \
+    } while (0);
+
+  /**
+   * @brief Used to send a command with a single trailing integer parameter 
+   * and return automatically in case of failure, for example: 
+   * AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, "+ipr=", 6 ) -> "at+ipr=6\r"
+   */
+  #define AT_UART_SEND_INT_CMD_OR_RET( ret, at_uart, cmd, value ) \
+    do { \
+      ret = at_uart_send_int_cmd( \
+        at_uart, AT_STR cmd, AT_CMD_LEN( AT_STR cmd ), value ); \
+      AT_UART_RET_IF_ERR( ret ); \
+    } while (0);
+
   /**
    * @brief Used to send a command and return automatically in case
    * of failure
@@ -55,21 +80,104 @@
     AT_UART_OVERFLOW,
     AT_UART_ERR,
     AT_UART_UNK,
+    AT_UART_ECHO, // the echo does not match the transmitted command
   } at_uart_err_t;
 
   typedef struct at_uart_config {
     bool echo;
     bool verbose;
+
+    /**
+     * @brief Baudrate negotiated with the DCE during setup using AT+IPR,
+     * the current baudrate is kept if the negotiation fails.
+     * If the DCE does not answer at the boot baudrate (e.g. only the host
+     * has been reset) setup is retried using this one.
+     * Use 0 to keep the current UART baudrate
+     */
+    uint32_t baudrate;
+
+    /**
+     * @brief Applies quiet, echo and verbose settings in one command line
+     * and flow control and DTR in another one, instead of one command per setting.
+     * Individual commands are used if the batched lines fail
+     */
+    bool batch;
+
     zuart_config_t zuart;
   } at_uart_config_t;
 
-  typedef struct at_uart {
+  typedef struct at_uart at_uart_t;
+
+  /**
+   * @brief Unsolicited result code handler
+   * 
+   * @param line Null terminated URC line (without trailing chars)
+   * @param len Line length
+   * @param user_data See at_uart_set_urc_handler()
+   */
+  typedef void (*at_uart_urc_cb_t)( 
+    at_uart_t *at_uart, const char *line, uint16_t len, void *user_data );
+
+  /**
+   * @brief Response consumer used by at_uart_stream_resp(). Information lines
+   * are delivered in one or more chunks, result codes and URCs are never delivered
+   * 
+   * @param data Chunk of the current line (not null terminated), may be empty
+   * @param len Chunk length
+   * @param line_end The current line has been completed with this chunk
+   * @param user_data See at_uart_stream_resp()
+   */
+  typedef void (*at_uart_resp_cb_t)( 
+    at_uart_t *at_uart, const char *data, uint16_t len, bool line_end, void *user_data );
+
+  /**
+   * @brief Binary data consumer used by at_uart_read_stream()
+   * 
+   * @param data Received chunk, only valid during the call
+   * @param len Chunk length
+   * @param user_data See at_uart_read_stream()
+   */
+  typedef void (*at_uart_data_cb_t)( 
+    at_uart_t *at_uart, const uint8_t *data, uint16_t len, void *user_data );
+
+  struct at_uart {
     bool _echoed;
     unsigned char eol; // end of line char
+
+    // shadow copy of the last transmitted command, used to verify its echo
+    char tx_shadow[ CONFIG_AT_UART_ECHO_SHADOW_SIZE ];
+    uint16_t tx_len; // length of the whole command, may exceed the shadow
+
+    // upper bound applied to every operation, see at_uart_set_deadline()
+    k_timepoint_t deadline;
+
+    // last result code recognized while parsing a response, see at_uart_get_code()
+    at_code_t code;
+
+    // unsolicited result codes, see at_uart_set_urc_handler()
+    const char *const *urcs;
+    uint8_t n_urcs;
+    at_uart_urc_cb_t urc_cb;
+    void *urc_user_data;
+
+    // parser used by at_uart_wait_urc(), it is kept between calls so a line
+    // partially received when a wait expires is completed by the next one
+    at_parser_t urc_parser;
+    at_uart_err_t urc_ret; // kind of the last line completed by urc_parser
   
     zuart_t zuart;
     at_uart_config_t config;
-  } at_uart_t;
+  };
+
+  /**
+   * @brief Returns the last result code (final or intermediate) recognized
+   * by the last at_uart_parse_resp() call
+   * 
+   * @return at_code_t AT_CODE_NONE if the response did not contain a result code
+   */
+  static inline at_code_t at_uart_get_code( at_uart_t *at_uart ) {
+    return at_uart->code;
+  }
 
   /**
    * @brief Setup AT UART module
@@ -101,11 +209,102 @@
     const char *at_cmd_tmpl, va_list args
   );
 
+  /**
+   * @brief Sends a command with a single trailing integer parameter,
+   * formatted without using the printf family
+   * 
+   * @param cmd Command prefix including "at", for example: "at+sbdwb="
+   * @param cmd_len Prefix length (skipping null terminated char)
+   * @param value Parameter value appended to the prefix
+   * @return at_uart_err_t AT_UART_OVERFLOW if the prefix is too long
+   */
+  at_uart_err_t at_uart_send_int_cmd(
+    at_uart_t *at_uart, const char *cmd, uint16_t cmd_len, uint32_t value );
+
   at_uart_err_t at_uart_write( 
     at_uart_t *at_uart, const uint8_t *src_buf, uint16_t n_bytes, uint32_t timeout_ms );
 
   at_uart_err_t at_uart_read(
     at_uart_t *at_uart, uint8_t *out_buf, uint16_t n_bytes, uint32_t timeout_ms );
+
+  /**
+   * @brief Bounds every following operation by the given absolute deadline,
+   * relative timeouts of individual operations are clamped to it.
+   * Use sys_timepoint_calc( K_FOREVER ) to remove the bound
+   * 
+   * @param deadline See sys_timepoint_calc()
+   */
+  void at_uart_set_deadline( at_uart_t *at_uart, k_timepoint_t deadline );
+
+  /**
+   * @brief Registers the prefixes of the unsolicited result codes which must be
+   * diverted to the given handler. Matching lines are never part of a command
+   * response, no matter which command is being parsed
+   * 
+   * @param urcs URC prefixes, see at_parser_set_urcs(). Must outlive the instance
+   * @param n_urcs Number of prefixes
+   * @param cb URC handler, called from the thread which is parsing the response
+   * @param user_data Passed to the handler
+   */
+  void at_uart_set_urc_handler( 
+    at_uart_t *at_uart, const char *const *urcs, uint8_t n_urcs,
+    at_uart_urc_cb_t cb, void *user_data );
+
+  /**
+   * @brief Waits for received lines until an unsolicited result code is
+   * delivered to the registered handler. A line which has not been completely
+   * received when the deadline expires is resumed by the next call
+   * 
+   * @param deadline See sys_timepoint_calc()
+   * @return at_uart_err_t AT_UART_OK if an URC was delivered, AT_UART_UNK if 
+   * any other line was received, AT_UART_TIMEOUT otherwise
+   */
+  at_uart_err_t at_uart_wait_urc( at_uart_t *at_uart, k_timepoint_t deadline );
+
+  at_uart_err_t at_uart_write_deadline( 
+    at_uart_t *at_uart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline );
+
+  /**
+   * @brief Writes the given segments as a single transfer, see zuart_writev()
+   * 
+   * @param iov Segments to write, for example: header, body and trailer
+   * @param iovcnt Number of segments
+   * @param written Optional, total number of bytes written. On partial writes
+   * it can be used to locate the segment which was not completely written
+   * @param timeout_ms Bounds the whole write
+   * @return at_uart_err_t 
+   */
+  at_uart_err_t at_uart_writev( 
+    at_uart_t *at_uart, const zuart_iovec_t *iov, uint8_t iovcnt, 
+    uint32_t *written, uint32_t timeout_ms );
+
+  /**
+   * @brief Same as at_uart_writev() but bounded by an absolute deadline
+   */
+  at_uart_err_t at_uart_writev_deadline( 
+    at_uart_t *at_uart, const zuart_iovec_t *iov, uint8_t iovcnt, 
+    uint32_t *written, k_timepoint_t deadline );
+
+  /**
+   * @brief Same as at_uart_read() but bounded by an absolute deadline
+   */
+  at_uart_err_t at_uart_read_deadline(
+    at_uart_t *at_uart, uint8_t *out_buf, uint16_t n_bytes, k_timepoint_t deadline );
+
+  /**
+   * @brief Reads the given number of bytes handing them to the given consumer 
+   * as they are received, so no output buffer is needed. When zero-copy reception
+   * is supported chunks are delivered in place from the reception buffer
+   * 
+   * @param n_bytes Number of bytes to read
+   * @param cb Data consumer, use NULL to discard the bytes
+   * @param user_data Passed to the consumer
+   * @param deadline Bounds the whole read, see sys_timepoint_calc()
+   * @return at_uart_err_t 
+   */
+  at_uart_err_t at_uart_read_stream_deadline(
+    at_uart_t *at_uart, uint16_t n_bytes, 
+    at_uart_data_cb_t cb, void *user_data, k_timepoint_t deadline );
   
   /**
    * @brief Writes the given AT command directly to serial port
@@ -118,15 +317,91 @@
    * @return at_uart_code_t 
    */
   at_uart_err_t at_uart_write_cmd(
-    at_uart_t *at_uart, char *cmd, uint16_t cmd_len );
+    at_uart_t *at_uart, const char *cmd, uint16_t cmd_len );
+
+  /**
+   * @brief Same as at_uart_write_cmd() but the command is given in segments,
+   * so it does not need to be assembled in an intermediate buffer
+   * 
+   * @param iov Command segments, for example: AT_STR, command body and EOL
+   * @param iovcnt Number of segments
+   * @return at_uart_err_t 
+   */
+  at_uart_err_t at_uart_write_cmdv(
+    at_uart_t *at_uart, const zuart_iovec_t *iov, uint8_t iovcnt );
 
+  /**
+   * @brief Consumes the echo of the last command written with at_uart_write_cmd(),
+   * it is compared against the transmitted command as bytes arrive
+   * 
+   * @note Does nothing if echo is disabled or it has already been checked.
+   * URCs received ahead of the echo are dispatched and skipped
+   * 
+   * @return at_uart_err_t AT_UART_ECHO if a byte of the echo does not match,
+   * in that case received lines are dropped, except URCs which are dispatched
+   */
   at_uart_err_t at_uart_check_echo( at_uart_t *at_uart );
 
+  /**
+   * @brief Parses an AT command response, the given timeout
+   * bounds the whole response, not each received byte
+   */
   at_uart_err_t at_uart_parse_resp( 
     at_uart_t *at_uart, 
     char *str_resp, uint16_t str_resp_len, 
     uint8_t lines, uint16_t timeout_ms );
+
+  /**
+   * @brief Feeds received bytes into the given parser until its token handler
+   * stops it or the deadline expires. The parser state is kept, so parsing can
+   * be resumed with a later call. Use a K_NO_WAIT deadline to only feed the 
+   * bytes which have already been received
+   * 
+   * @note Bytes after the token which stopped the parser are not consumed
+   * 
+   * @param parser Parser to feed, see at_parser_init()
+   * @param deadline See sys_timepoint_calc()
+   * @return at_uart_err_t AT_UART_OK if the parser was stopped, 
+   * AT_UART_TIMEOUT otherwise
+   */
+  at_uart_err_t at_uart_pump( 
+    at_uart_t *at_uart, at_parser_t *parser, k_timepoint_t deadline );
+
+  /**
+   * @brief Same as at_uart_parse_resp() but bounded by an absolute deadline
+   */
+  at_uart_err_t at_uart_parse_resp_deadline( 
+    at_uart_t *at_uart, 
+    char *str_resp, uint16_t str_resp_len, 
+    uint8_t lines, k_timepoint_t deadline );
   
+  /**
+   * @brief Parses an AT command response like at_uart_parse_resp(), but 
+   * information lines are handed to the given consumer as they are received,
+   * without an intermediate buffer. Line endings and result codes are 
+   * handled as in at_uart_parse_resp()
+   * 
+   * @note The beginning of each line (up to AT_PARSER_HOLD_SIZE - 1 chars) is held
+   * back until it can not be a result code or an URC, the rest of the line is 
+   * delivered in place as it is received
+   * 
+   * @param cb Response consumer, called from the calling thread
+   * @param user_data Passed to the consumer
+   * @param lines Expected lines, see at_uart_parse_resp()
+   * @param timeout_ms Bounds the whole response
+   * @return at_uart_err_t 
+   */
+  at_uart_err_t at_uart_stream_resp( 
+    at_uart_t *at_uart, at_uart_resp_cb_t cb, void *user_data, 
+    uint8_t lines, uint16_t timeout_ms );
+
+  /**
+   * @brief Same as at_uart_stream_resp() but bounded by an absolute deadline
+   */
+  at_uart_err_t at_uart_stream_resp_deadline( 
+    at_uart_t *at_uart, at_uart_resp_cb_t cb, void *user_data, 
+    uint8_t lines, k_timepoint_t deadline );
+
   at_uart_err_t at_uart_get_resp_code( 
     at_uart_t *at_uart, 
     char *str_buf, uint16_t str_buf_len, 
@@ -144,6 +419,25 @@
    */
   const char *at_uart_err_to_name( at_uart_err_t code );
 
+  /**
+   * @brief Switches both the DCE (using AT+IPR) and the host UART to the given
+   * baudrate. The link is verified with a probe using the new baudrate, 
+   * if it fails the previous baudrate is restored on both sides
+   * 
+   * @param baudrate One of 600, 1200, 2400, 4800, 9600, 19200, 38400, 57600 or 115200
+   * @return at_uart_err_t AT_UART_ERR if the baudrate is not supported or
+   * the previous baudrate had to be restored
+   */
+  at_uart_err_t at_uart_set_baudrate( at_uart_t *at_uart, uint32_t baudrate );
+
+  /**
+   * @brief Forgets the fingerprint of the configuration stored in the modem,
+   * so the next setup applies and stores the whole configuration again.
+   * Should be used if the modem is replaced or its profiles are modified.
+   * Does nothing unless CONFIG_AT_UART_FAST_START is enabled
+   */
+  void at_uart_profile_invalidate( at_uart_t *at_uart );
+
   at_uart_err_t at_uart_set_dtr( at_uart_t *at_uart, uint8_t option );
   at_uart_err_t at_uart_set_flow_control( at_uart_t *at_uart, uint8_t option );
   at_uart_err_t at_uart_store_active_config( at_uart_t *at_uart, uint8_t profile );
@@ -1,4 +1,5 @@
 #include "inc/isu/dte.h"
+#include "inc/isu/evt.h"
 
 int isu_dte_get_err( isu_dte_t *isbd ) {
   return isbd->err;
@@ -8,12 +9,27 @@ isu_dte_err_t isu_dte_setup( isu_dte_t *isbd, isu_dte_config_t *isu_dte_config )
 
   isbd->config = *isu_dte_config;
 
+  // the ISU may have been replaced since the last setup
+  isu_dte_identity_invalidate( isbd );
+
+  // unsolicited result codes are diverted from the very first command
+  isu_dte_evt_setup( isbd );
+
+  k_fifo_init( &isbd->cmd_fifo );
+
   at_uart_err_t ret = at_uart_setup( 
     &isbd->at_uart, &isu_dte_config->at_uart );
 
   return ret == AT_UART_OK ? ISU_DTE_OK : ISU_DTE_ERR_SETUP;
 }
 
+void isu_dte_identity_invalidate( isu_dte_t *dte ) {
+#ifdef CONFIG_ISU_DTE_IDENTITY_CACHE
+  dte->identity.imei[ 0 ] = '\0';
+  dte->identity.revision[ 0 ] = '\0';
+#endif
+}
+
 isu_dte_err_t isu_dte_send_tiny_cmd( isu_dte_t *isbd, const char *at_cmd_tmpl, ... ) {
   
   va_list args;
@@ -31,8 +47,91 @@ isu_dte_err_t isu_dte_send_tiny_cmd( isu_dte_t *isbd, const char *at_cmd_tmpl, .
   return err == AT_UART_OK ? ISU_DTE_OK : ISU_DTE_ERR_AT;
 }
 
+isu_dte_err_t isu_dte_write_cmd( isu_dte_t *isbd, const char *cmd, uint16_t cmd_len ) {
+
+  at_uart_err_t err = at_uart_write_cmd( &isbd->at_uart, cmd, cmd_len );
+
+  isbd->err = err;
+
+  return err == AT_UART_OK ? ISU_DTE_OK : ISU_DTE_ERR_AT;
+}
+
+isu_dte_err_t isu_dte_send_int_cmd( 
+  isu_dte_t *isbd, const char *cmd, uint16_t cmd_len, uint32_t value 
+) {
+
+  at_uart_err_t err = at_uart_send_int_cmd( &isbd->at_uart, cmd, cmd_len, value );
+
+  isbd->err = err;
+
+  return err == AT_UART_OK ? ISU_DTE_OK : ISU_DTE_ERR_AT;
+}
+
 isu_dte_err_t isu_dte_send_cmd( isu_dte_t *isbd, const char *at_cmd_tmpl, ... ) { 
   return ISU_DTE_ERR_CMD; 
 }
 
+void isu_dte_cmd_submit( isu_dte_t *dte, isu_dte_cmd_t *cmd ) {
+  k_fifo_put( &dte->cmd_fifo, cmd );
+}
+
+bool isu_dte_cmd_process( isu_dte_t *dte, k_timeout_t timeout ) {
+
+  isu_dte_cmd_t *cmd = k_fifo_get( &dte->cmd_fifo, timeout );
+
+  if ( cmd == NULL ) {
+    return false;
+  }
+
+  // "at" + command + EOL, the command is written as is
+  zuart_iovec_t iov[] = {
+    { .buf = (const uint8_t*) AT_STR, .len = AT_CMD_LEN( AT_STR ) },
+    { .buf = (const uint8_t*) cmd->cmd, .len = strlen( cmd->cmd ) },
+    { .buf = (const uint8_t*) AT_CMD_EOL_STR, .len = AT_CMD_LEN( AT_CMD_EOL_STR ) },
+  };
+
+  cmd->err = at_uart_write_cmdv( &dte->at_uart, iov, ARRAY_SIZE( iov ) );
+
+  if ( cmd->err == AT_UART_OK ) {
+    cmd->err = at_uart_parse_resp_deadline( 
+      &dte->at_uart, cmd->resp, cmd->resp_size, cmd->lines, 
+      sys_timepoint_calc( K_MSEC( cmd->timeout_ms ) ) );
+  }
+
+  dte->err = cmd->err;
+
+  if ( cmd->cb ) {
+    cmd->cb( dte, cmd );
+  }
 
+#ifdef CONFIG_POLL
+  if ( cmd->signal ) {
+    k_poll_signal_raise( cmd->signal, cmd->err );
+  }
+#endif
+
+  return true;
+}
+
+#ifdef CONFIG_POLL
+bool isu_dte_poll( isu_dte_t *dte, k_timeout_t timeout ) {
+
+  struct k_poll_event events[ 2 ];
+
+  // ! Reception signals are cleared before buffered bytes are checked,
+  // ! so bytes received in between still wake the thread up
+  if ( !zuart_rx_poll_event_init( &dte->at_uart.zuart, &events[ 0 ] )
+      || k_msgq_num_used_get( &dte->evt_msgq ) > 0
+      || zuart_available( &dte->at_uart.zuart ) > 0 ) {
+    return true;
+  }
+
+  k_poll_event_init( 
+    &events[ 1 ], K_POLL_TYPE_FIFO_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, 
+    &dte->cmd_fifo );
+
+  k_poll( events, ARRAY_SIZE( events ), timeout );
+
+  return events[ 0 ].state == K_POLL_STATE_SEM_AVAILABLE;
+}
+#endif
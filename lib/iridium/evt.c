@@ -1,8 +1,13 @@
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
 #include "stru.h"
 
 #include "isu/dte.h"
 #include "isu/evt.h"
 
+LOG_MODULE_REGISTER( isu_evt );
+
 #define VCODE_RING_STR    "SBDRING"
 #define CODE_RING_STR     "126"
 
@@ -10,48 +15,89 @@ static inline bool _evt_parse_areg( const char *buf, isu_dte_evt_t *evt );
 static inline bool _evt_parse_ciev( const char *buf, isu_dte_evt_t *evt );
 static inline bool _evt_parse_ring( const char *buf, isu_dte_evt_t *evt, bool verbose );
 
-isu_dte_err_t isu_dte_evt_wait( isu_dte_t *dte, isu_dte_evt_t *event, uint32_t timeout_ms ) {
+// unsolicited result codes which are diverted into the event queue
+static const char *const g_vurcs[] = { "+CIEV:", "+AREG:", VCODE_RING_STR };
+static const char *const g_urcs[] = { "+CIEV:", "+AREG:", CODE_RING_STR };
 
-  char buf[ 32 ];
-  event->id = ISU_DTE_EVT_UNK;
+/**
+ * @brief Parses unsolicited result codes and pushes the resulting events
+ * into the DTE event queue. Called while any response is being parsed
+ */
+static void _evt_urc_handler( 
+  at_uart_t *at_uart, const char *line, uint16_t len, void *user_data 
+) {
 
-  dte->err = at_uart_parse_resp(
-    &dte->at_uart, buf, sizeof( buf ), AT_1_LINE_RESP, timeout_ms );
+  isu_dte_t *dte = user_data;
+  isu_dte_evt_t evt;
 
-  bool verbose = dte->at_uart.config.verbose;
+  bool verbose = at_uart->config.verbose;
 
-  if ( dte->err == AT_UART_UNK ) {
-    
-    if ( _evt_parse_ciev( buf, event )
-      || _evt_parse_areg( buf, event )
-      || _evt_parse_ring( buf, event, verbose ) ) {
-      
-      return ISU_DTE_OK;
+  if ( _evt_parse_ciev( line, &evt )
+    || _evt_parse_areg( line, &evt )
+    || _evt_parse_ring( line, &evt, verbose ) ) {
+
+    if ( k_msgq_put( &dte->evt_msgq, &evt, K_NO_WAIT ) != 0 ) {
+      LOG_WRN( "Event queue full, event %d dropped", evt.id );
     }
+  }
+}
+
+void isu_dte_evt_setup( isu_dte_t *dte ) {
 
-    return ISU_DTE_ERR_UNK;
+  k_msgq_init( 
+    &dte->evt_msgq, (char*) dte->evt_msgq_buf, 
+    sizeof( isu_dte_evt_t ), ARRAY_SIZE( dte->evt_msgq_buf ) );
+
+  if ( dte->config.at_uart.verbose ) {
+    at_uart_set_urc_handler( 
+      &dte->at_uart, g_vurcs, ARRAY_SIZE( g_vurcs ), _evt_urc_handler, dte );
+  } else {
+    at_uart_set_urc_handler( 
+      &dte->at_uart, g_urcs, ARRAY_SIZE( g_urcs ), _evt_urc_handler, dte );
   }
+}
+
+isu_dte_err_t isu_dte_evt_wait( isu_dte_t *dte, isu_dte_evt_t *event, uint32_t timeout_ms ) {
+  return isu_dte_evt_wait_deadline( 
+    dte, event, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
 
-  // We expect AT to return unknown,
-  // if the result code is AT_UART_OK means that the response
-  // was a literal OK string and we are not expecting that ...
-  return dte->err == AT_UART_OK
+isu_dte_err_t isu_dte_evt_wait_deadline( 
+  isu_dte_t *dte, isu_dte_evt_t *event, k_timepoint_t deadline 
+) {
+
+  event->id = ISU_DTE_EVT_UNK;
+
+  // events received while other commands were being executed
+  if ( k_msgq_get( &dte->evt_msgq, event, K_NO_WAIT ) == 0 ) {
+    return ISU_DTE_OK;
+  }
+
+  dte->err = at_uart_wait_urc( &dte->at_uart, deadline );
+
+  if ( k_msgq_get( &dte->evt_msgq, event, K_NO_WAIT ) == 0 ) {
+    return ISU_DTE_OK;
+  }
+
+  // We expect an unsolicited result code,
+  // any other line (or an unknown URC) is not expected ...
+  return dte->err == AT_UART_OK || dte->err == AT_UART_UNK
     ? ISU_DTE_ERR_UNK
     : ISU_DTE_ERR_AT;
-
 }
 
 static inline bool _evt_parse_ciev( const char *buf, isu_dte_evt_t *evt ) {
 
-  uint8_t ciev_evt, ciev_val;
+  static const uint16_t max[] = { UINT8_MAX, UINT8_MAX };
+  uint16_t fields[ 2 ];
 
   evt->id = ISU_DTE_EVT_UNK;
 
-  int ret = sscanf( buf, "+CIEV:%hhu,%hhu",
-    &ciev_evt, &ciev_val );
-
-  if ( ret == 2 ) {
+  if ( at_parse_uints( buf, "+CIEV:", fields, max, 2 ) == 2 ) {
     
+    uint8_t ciev_evt = fields[ 0 ], 
+            ciev_val = fields[ 1 ];
+
     if ( ciev_evt == 0 ) {
       evt->id = ISU_DTE_EVT_SIGQ;
       evt->sigq = ciev_val;
@@ -67,12 +113,12 @@ static inline bool _evt_parse_ciev( const char *buf, isu_dte_evt_t *evt ) {
 
 static inline bool _evt_parse_ring( const char *buf, isu_dte_evt_t *evt, bool verbose ) {
 
+  at_code_t code;
+
   evt->id = ISU_DTE_EVT_UNK;
   
-  const char *ring_str = 
-    verbose ? VCODE_RING_STR : CODE_RING_STR;
-  
-  if ( streq( buf, ring_str ) ) {
+  if ( at_parser_code_from_str( verbose, buf, &code ) 
+      && code == AT_CODE_SBDRING ) {
     evt->id = ISU_DTE_EVT_RING;
     return true;
   }
@@ -84,14 +130,13 @@ static inline bool _evt_parse_areg( const char *buf, isu_dte_evt_t *evt ) {
 
   evt->id = ISU_DTE_EVT_UNK;
 
-  uint8_t areg_evt, areg_err;
-  int ret = sscanf( buf, "+AREG:%hhu,%hhu",
-    &areg_evt, &areg_err );
+  static const uint16_t max[] = { UINT8_MAX, UINT8_MAX };
+  uint16_t fields[ 2 ];
 
-  if ( ret == 2 ) {
+  if ( at_parse_uints( buf, "+AREG:", fields, max, 2 ) == 2 ) {
     evt->id = ISU_DTE_EVT_AREG;
-    evt->areg.evt = areg_evt;
-    evt->areg.err = areg_err;
+    evt->areg.evt = fields[ 0 ];
+    evt->areg.err = fields[ 1 ];
     return true;
   }
 
@@ -3,6 +3,7 @@
 
   #include <stdint.h>
 
+  #include "isu.h"
   #include "isu/dte.h"
   #include "isu/evt.h"
 
@@ -21,11 +22,15 @@
     uint8_t retries;
     uint8_t *data;
     uint16_t len;
+
+    // used instead of data for streamed messages, see isbd_send_mo_stream()
+    isu_mo_producer_t producer;
+    void *user_data;
   };
 
   struct isbd_mt_msg {
     uint16_t sn;
-    uint8_t *data;
+    uint8_t *data; // NULL if the message was handed to isbd_config_t.mt_sink
     uint16_t len;
   };
 
@@ -68,11 +73,33 @@
     uint8_t mo_queue_len;
     uint8_t evt_queue_len;
     isu_dte_t *dte;
+
+    // optional, MT messages are handed to this sink as they are received
+    // instead of being allocated, see isu_get_mt_stream(). Delivered data 
+    // is only valid once the corresponding ISBD_EVT_MT event is received
+    isu_mt_sink_t mt_sink;
+    void *mt_user_data;
   } isbd_config_t;
 
   isbd_err_t isbd_setup( isbd_config_t *isbd_conf );
   isbd_err_t isbd_send_mo_msg( const uint8_t *msg, uint16_t msg_len, uint8_t retries );
 
+  /**
+   * @brief Same as isbd_send_mo_msg() but the message is not copied, it is 
+   * requested to the given producer when the session is started
+   * (once per attempt), see isu_set_mo_stream()
+   * 
+   * @note The data used by the producer must be kept until the 
+   * corresponding ISBD_EVT_MO event (or ISBD_EVT_ERR) is received
+   * 
+   * @param msg_len Message length
+   * @param producer Message producer, called from the service thread
+   * @param user_data Passed to the producer
+   * @param retries Number of retries
+   */
+  isbd_err_t isbd_send_mo_stream( 
+    uint16_t msg_len, isu_mo_producer_t producer, void *user_data, uint8_t retries );
+
   /**
    * @brief Request a session
    * 
@@ -3,6 +3,34 @@
 
   #include <stdint.h>
 
+  /**
+   * @brief Incremental checksum state, the checksum of a message can be
+   * computed while the message is streamed, see isbd_util_csum_update()
+   */
+  typedef struct isbd_util_csum {
+    uint32_t sum;
+  } isbd_util_csum_t;
+
+  /**
+   * @brief Initializes the given checksum state
+   */
+  void isbd_util_csum_init( isbd_util_csum_t *csum );
+
+  /**
+   * @brief Adds the given chunk to the checksum state. Chunks may have
+   * any length and alignment, the result does not depend on how 
+   * the message is split
+   * 
+   * @param buf Chunk buffer
+   * @param len Chunk length
+   */
+  void isbd_util_csum_update( isbd_util_csum_t *csum, const uint8_t *buf, uint16_t len );
+
+  /**
+   * @brief Returns the checksum of all the chunks added so far
+   */
+  uint16_t isbd_util_csum_final( const isbd_util_csum_t *csum );
+
   /**
    * @brief Computes the checksum from the given message buffer
    *
@@ -12,4 +40,20 @@
    */
   uint16_t isbd_util_compute_checksum( const uint8_t *msg_buf, uint16_t msg_buf_len );
 
+  /**
+   * @brief Checksum kernels, they return the sum of the given bytes.
+   * isbd_util_csum_update() uses the fastest one available for the target,
+   * they are exposed for testing and benchmarking purposes
+   * 
+   * - ref: byte at a time, reference implementation
+   * - swar: aligned 32-bit words, two 16-bit lanes per word
+   * - simd32: ARM DSP extension ( USADA8 ), only if __ARM_FEATURE_SIMD32 is defined
+   */
+  uint32_t isbd_util_sum_ref( const uint8_t *buf, uint16_t len );
+  uint32_t isbd_util_sum_swar( const uint8_t *buf, uint16_t len );
+
+  #if defined( __ARM_FEATURE_SIMD32 )
+    uint32_t isbd_util_sum_simd32( const uint8_t *buf, uint16_t len );
+  #endif
+
 #endif
@@ -3,6 +3,33 @@
 
   #include "isu/dte.h"
 
+  /**
+   * @brief MO message producer, used to stream a message without 
+   * a contiguous buffer, see isu_set_mo_stream()
+   * 
+   * @param buf Destination buffer
+   * @param offset Offset of the first requested byte within the message,
+   * the same range can be requested more than once (for example on retries)
+   * @param size Number of requested bytes
+   * @param user_data See isu_set_mo_stream()
+   * @return uint16_t Number of bytes produced, less than size if the message
+   * could not be produced completely
+   */
+  typedef uint16_t (*isu_mo_producer_t)( 
+    uint8_t *buf, uint16_t offset, uint16_t size, void *user_data );
+
+  /**
+   * @brief MT message sink, used to stream a message without 
+   * an intermediate buffer, see isu_get_mt_stream()
+   * 
+   * @param chunk Received chunk, only valid during the call
+   * @param offset Offset of the chunk within the message
+   * @param len Chunk length
+   * @param user_data See isu_get_mt_stream()
+   */
+  typedef void (*isu_mt_sink_t)( 
+    const uint8_t *chunk, uint16_t offset, uint16_t len, void *user_data );
+
   typedef enum isu_clear_buffer {
 
     /**
@@ -116,6 +143,9 @@
   /**
    * @brief Query the device IMEI
    * 
+   * @note Served from RAM after the first query 
+   * if CONFIG_ISU_DTE_IDENTITY_CACHE is enabled
+   * 
    * @param imei Resulting IMEI memory buffer
    * @return int8_t Output buffer size
    */          
@@ -126,6 +156,9 @@
   /**
    * @brief Query the device revision
    * 
+   * @note Served from RAM after the first query 
+   * if CONFIG_ISU_DTE_IDENTITY_CACHE is enabled
+   * 
    * @param rev Output revision buffer 
    * @return int8_t Output buffer size
    */
@@ -133,6 +166,21 @@
     isu_dte_t *dte, char *rev, size_t rev_len 
   );
 
+  /**
+   * @brief Query the device revision, each line of the multi-line 
+   * response is handed to the given consumer as it is received
+   * 
+   * @note If CONFIG_ISU_DTE_IDENTITY_CACHE is enabled the revision is cached 
+   * first and every line is delivered in a single chunk
+   * 
+   * @param cb Response consumer, see at_uart_stream_resp()
+   * @param user_data Passed to the consumer
+   * @return isu_dte_err_t 
+   */
+  isu_dte_err_t isu_get_revision_stream( 
+    isu_dte_t *dte, at_uart_resp_cb_t cb, void *user_data 
+  );
+
   /**
    * @brief Transfer a SBD text message from the DTE 
    * to the single mobile originated buffer.
@@ -179,6 +227,34 @@
     isu_dte_t *dte, uint8_t *msg, uint16_t *msg_len, uint16_t *csum 
   );
 
+  /**
+   * @brief Same as isu_get_mt() but the message is handed to the given sink
+   * in chunks as it is received, while its checksum is verified
+   * 
+   * @note The sink may receive the whole message before the checksum 
+   * is known, so delivered data must not be used until ISU_DTE_OK is returned
+   * 
+   * @param max_len Maximum message length, longer messages are consumed
+   * without calling the sink and ISU_DTE_ERR_AT is returned (AT_UART_OVERFLOW)
+   * @param sink MT message sink
+   * @param user_data Passed to the sink
+   * @param msg_len Output message length
+   * @return isu_dte_err_t ISU_DTE_ERR_CSUM if the checksum does not match
+   */
+  isu_dte_err_t isu_get_mt_stream( 
+    isu_dte_t *dte, uint16_t max_len, 
+    isu_mt_sink_t sink, void *user_data, uint16_t *msg_len 
+  );
+
+  /**
+   * @brief MT message sink which copies each chunk into a contiguous buffer,
+   * see isu_get_mt_stream()
+   * 
+   * @param user_data Destination buffer, at least max_len bytes long
+   */
+  void isu_mt_copy_sink( 
+    const uint8_t *chunk, uint16_t offset, uint16_t len, void *user_data );
+
   /**
    * @brief This command is used to transfer a binary SBD 
    * message from the DTE to the single mobile originated buffer 
@@ -193,6 +269,25 @@
     isu_dte_t *dte, const uint8_t *msg, uint16_t msg_len 
   );
 
+  /**
+   * @brief Same as isu_set_mo() but the message is requested in chunks to
+   * the given producer and streamed to the ISU while its checksum is computed,
+   * so the message does not need to be stored in a contiguous buffer
+   * 
+   * @note If the producer fails the announced length is completed with zeros
+   * and a wrong checksum, so the ISU rejects the message right away 
+   * and the MO buffer is not modified
+   * 
+   * @param msg_len MO message length
+   * @param producer MO message producer
+   * @param user_data Passed to the producer
+   * @return isu_dte_err_t ISU_DTE_ERR_PRODUCER if the producer failed,
+   * see isu_mo_producer_t
+   */
+  isu_dte_err_t isu_set_mo_stream( 
+    isu_dte_t *dte, uint16_t msg_len, isu_mo_producer_t producer, void *user_data 
+  );
+
   /**
    * @brief This command is used to transfer a text SBD message 
    * from the single mobile terminated buffer to the DTE
@@ -255,6 +350,19 @@
     isu_evt_report_t *evt_report, uint8_t *sigq, uint8_t *svca
   );
 
+  /**
+   * @brief Same as isu_set_evt_report() followed by isu_set_mt_alert(),
+   * but both commands are sent in a single command line 
+   * ( AT+CIER=...;+SBDMTA=... ), so only one response has to be awaited
+   * 
+   * @param alert Alert option, see isu_set_mt_alert()
+   * @return isu_dte_err_t 
+   */
+  isu_dte_err_t isu_set_evt_report_mt_alert( 
+    isu_dte_t *dte, isu_evt_report_t *evt_report, isu_mt_alert_t alert,
+    uint8_t *sigq, uint8_t *svca
+  );
+
   /**
    * @brief Enable or disable the ISU to listen for SBD Ring Alerts
    *  
@@ -18,18 +18,138 @@
     ISU_DTE_ERR_UNK,
     ISU_DTE_ERR_CMD,
     ISU_DTE_ERR_SETUP,
+    ISU_DTE_ERR_CSUM, // checksum mismatch
+    ISU_DTE_ERR_PRODUCER, // a message producer could not produce the whole message
   } isu_dte_err_t;
 
+  typedef enum isu_dte_evt_id {
+
+    ISU_DTE_EVT_UNK,
+
+    /**
+     * @brief Ring alert
+    */
+    ISU_DTE_EVT_RING,
+
+    /**
+     * @brief Signal quality
+    */
+    ISU_DTE_EVT_SIGQ,
+
+    /**
+     * @brief Service availability
+     */
+    ISU_DTE_EVT_SVCA,
+
+    /**
+     * @brief Automatic registration
+     */
+    ISU_DTE_EVT_AREG,
+
+  } isu_dte_evt_id_t;
+
+  typedef struct isu_dte_evt {
+    
+    isu_dte_evt_id_t id;
+    
+    union { 
+
+      uint8_t sigq; // signal quality (strength)
+      uint8_t svca; // service availability
+
+      struct {
+        uint8_t evt; 
+        uint8_t err; 
+      } areg;
+
+    };
+
+  } isu_dte_evt_t; // TODO: rename this again to isu_dte_evt_t :)
+
   typedef struct isu_dte_config {
     struct at_uart_config at_uart;
   } isu_dte_config_t;
 
+  /**
+   * @brief IMEI buffer size, 15 digits plus null char
+   */
+  #define ISU_DTE_IMEI_SIZE     16
+
+  #ifdef CONFIG_ISU_DTE_IDENTITY_CACHE
+    /**
+     * @brief Identity of the ISU, which never changes while it is attached.
+     * Empty strings are not cached yet
+     */
+    typedef struct isu_dte_identity {
+      char imei[ ISU_DTE_IMEI_SIZE ];
+      char revision[ CONFIG_ISU_DTE_REVISION_CACHE_SIZE ];
+    } isu_dte_identity_t;
+  #endif
+
   typedef struct isu_dte {
     int err;
     at_uart_t at_uart;
     isu_dte_config_t config;
+    
+    // unsolicited events received at any time, see isu_dte_evt_wait()
+    struct k_msgq evt_msgq;
+    isu_dte_evt_t evt_msgq_buf[ CONFIG_ISU_DTE_EVT_QUEUE_LEN ];
+
+    // submitted commands, see isu_dte_cmd_submit()
+    struct k_fifo cmd_fifo;
+
+  #ifdef CONFIG_ISU_DTE_IDENTITY_CACHE
+    // filled on first query, see isu_dte_identity_invalidate()
+    isu_dte_identity_t identity;
+  #endif
   } isu_dte_t;
 
+  typedef struct isu_dte_cmd isu_dte_cmd_t;
+
+  /**
+   * @brief Command completion callback, called from the thread
+   * which processes the command queue
+   */
+  typedef void (*isu_dte_cmd_cb_t)( isu_dte_t *dte, isu_dte_cmd_t *cmd );
+
+  /**
+   * @brief Descriptor of an asynchronously executed command. 
+   * The descriptor must remain valid until the command is completed
+   */
+  struct isu_dte_cmd {
+    void *_fifo_reserved; // first word reserved for use by k_fifo
+
+    const char *cmd; // command without AT prefix, for example: "+CSQ" or "+SBDMTA=1"
+    
+    char *resp; // response buffer, can be NULL
+    uint16_t resp_size;
+    uint8_t lines; // expected response lines, see AT_1_LINE_RESP, ...
+    uint32_t timeout_ms; // response timeout
+
+    isu_dte_cmd_cb_t cb; // optional completion callback
+    void *user_data;
+
+  #ifdef CONFIG_POLL
+    struct k_poll_signal *signal; // optional, raised with the resulting at_uart_err_t
+  #endif
+
+    at_uart_err_t err; // result, valid once the command has been completed
+  };
+
+  /**
+   * @brief Initializes a command descriptor
+   */
+  #define ISU_DTE_CMD_INIT( _cmd, _resp, _resp_size, _lines, _timeout_ms, _cb, _user_data ) \
+    { \
+      .cmd = _cmd, \
+      .resp = _resp, \
+      .resp_size = _resp_size, \
+      .lines = _lines, \
+      .timeout_ms = _timeout_ms, \
+      .cb = _cb, \
+      .user_data = _user_data, \
+    }
+
   /**
    * @brief Retrieve last reported error. 
    * This function can be used to obtain a more detailed error
@@ -40,7 +160,85 @@
   int isu_dte_get_err( isu_dte_t *dte );
 
   isu_dte_err_t isu_dte_setup( isu_dte_t *dte, struct isu_dte_config *config );
+
+  /**
+   * @brief Clears the cached identity of the ISU ( IMEI, revision, ... ),
+   * it must be called if the ISU is replaced or reset without calling
+   * isu_dte_setup() again. Next queries are answered by the ISU
+   * 
+   * @note Does nothing if CONFIG_ISU_DTE_IDENTITY_CACHE is not enabled
+   */
+  void isu_dte_identity_invalidate( isu_dte_t *dte );
+
+  /**
+   * @brief Sets an absolute deadline for every following isu_* command.
+   * Response timeouts of each command are clamped to it, so a sequence
+   * of commands has a hard upper bound.
+   * Use sys_timepoint_calc( K_FOREVER ) to remove the bound
+   * 
+   * @param deadline See sys_timepoint_calc()
+   */
+  static inline void isu_dte_set_deadline( isu_dte_t *dte, k_timepoint_t deadline ) {
+    at_uart_set_deadline( &dte->at_uart, deadline );
+  }
   isu_dte_err_t isu_dte_send_cmd( isu_dte_t *dte, const char *at_cmd_tmpl, ... );
+
+  /**
+   * @brief Enqueues a command to be executed asynchronously. This function
+   * does not block and can be called from any thread
+   * 
+   * @note Commands are executed by isu_dte_cmd_process(), when the Iridium SBD
+   * service is running its thread processes the queue between sessions.
+   * With CONFIG_POLL the idle service thread is woken up right away 
+   * ( see isu_dte_poll() ), otherwise the command may wait up to 
+   * CONFIG_ISBD_DTE_EVT_WAIT_TIMEOUT
+   * 
+   * @param cmd Command descriptor, see ISU_DTE_CMD_INIT()
+   */
+  void isu_dte_cmd_submit( isu_dte_t *dte, isu_dte_cmd_t *cmd );
+
+  /**
+   * @brief Executes the next submitted command (if any) and notifies its completion.
+   * 
+   * @note Must be called from the thread which owns the DTE, 
+   * as commands are written directly to the serial port
+   * 
+   * @param timeout Maximum time to wait for a command to be submitted
+   * @return true A command has been processed
+   */
+  bool isu_dte_cmd_process( isu_dte_t *dte, k_timeout_t timeout );
+
+#ifdef CONFIG_POLL
+  /**
+   * @brief Sleeps until something has to be done by the thread which owns
+   * the DTE: bytes are received from the ISU, events are queued 
+   * or a command is submitted
+   * 
+   * @note If reception is not signalled by the current serial mode
+   * ( see zuart_rx_poll_event_init() ) it returns true right away
+   * 
+   * @param timeout Maximum time to sleep
+   * @return true Events may be available, see isu_dte_evt_wait(). 
+   * false if a command was submitted or the timeout expired
+   */
+  bool isu_dte_poll( isu_dte_t *dte, k_timeout_t timeout );
+#endif
+
   isu_dte_err_t isu_dte_send_tiny_cmd( isu_dte_t *dte, const char *at_cmd_tmpl, ... );
 
+  /**
+   * @brief Sends an already formatted command, see AT_CMD()
+   * 
+   * @param cmd Command string including "at" prefix and EOL
+   * @param cmd_len Command length (skipping null terminated char)
+   */
+  isu_dte_err_t isu_dte_write_cmd( isu_dte_t *dte, const char *cmd, uint16_t cmd_len );
+
+  /**
+   * @brief Sends a command with a single trailing integer parameter,
+   * see at_uart_send_int_cmd()
+   */
+  isu_dte_err_t isu_dte_send_int_cmd( 
+    isu_dte_t *dte, const char *cmd, uint16_t cmd_len, uint32_t value );
+
 #endif
\ No newline at end of file
@@ -5,52 +5,9 @@
 
   #include "../isu/dte.h"
 
-  typedef enum isu_dte_evt_id {
-
-    ISU_DTE_EVT_UNK,
-
-    /**
-     * @brief Ring alert
-    */
-    ISU_DTE_EVT_RING,
-
-    /**
-     * @brief Signal quality
-    */
-    ISU_DTE_EVT_SIGQ,
-
-    /**
-     * @brief Service availability
-     */
-    ISU_DTE_EVT_SVCA,
-
-    /**
-     * @brief Automatic registration
-     */
-    ISU_DTE_EVT_AREG,
-
-  } isu_dte_evt_id_t;
-
-  typedef struct isu_dte_evt {
-    
-    isu_dte_evt_id_t id;
-    
-    union { 
-
-      uint8_t sigq; // signal quality (strength)
-      uint8_t svca; // service availability
-
-      struct {
-        uint8_t evt; 
-        uint8_t err; 
-      } areg;
-
-    };
-
-  } isu_dte_evt_t; // TODO: rename this again to isu_dte_evt_t :)
-
   /**
-   * @brief Waits for any event triggered over DTE by the ISU 
+   * @brief Waits for any event triggered over DTE by the ISU. Events received
+   * while other commands were being executed are queued and returned first
    * 
    * @param dte ISU Data Terminal Equipment
    * @param event A pointer where the resulting event should be stored
@@ -59,4 +16,18 @@
    */
   isu_dte_err_t isu_dte_evt_wait( isu_dte_t *dte, isu_dte_evt_t *event, uint32_t timeout_ms );
 
+  /**
+   * @brief Same as isu_dte_evt_wait() but bounded by an absolute deadline
+   */
+  isu_dte_err_t isu_dte_evt_wait_deadline( 
+    isu_dte_t *dte, isu_dte_evt_t *event, k_timepoint_t deadline );
+
+  /**
+   * @brief Initializes the DTE event queue and registers the unsolicited
+   * result codes which feed it. Called by isu_dte_setup()
+   * 
+   * @param dte ISU Data Terminal Equipment
+   */
+  void isu_dte_evt_setup( isu_dte_t *dte );
+
 #endif
\ No newline at end of file
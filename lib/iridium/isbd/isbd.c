@@ -50,26 +50,20 @@ K_THREAD_STACK_DEFINE(
 static struct isbd g_isbd;
 static struct k_thread g_thread_data;
 
-static inline bool _read_mt_msg( uint8_t *buf, uint16_t *buf_len ) {
-
-  uint16_t recv_csum;
+static inline bool _read_mt_msg( 
+  uint16_t *msg_len, isu_mt_sink_t sink, void *user_data 
+) {
 
+  // the checksum is verified while the message is received
   isu_dte_err_t ret = 
-    isu_get_mt( ISBD_DTE, buf, buf_len, &recv_csum );
-
-  if ( ret == ISU_DTE_OK ) {
-    
-    uint16_t host_csum =
-      isbd_util_compute_checksum( buf, *buf_len );
-    
-    return recv_csum == host_csum;
+    isu_get_mt_stream( ISBD_DTE, *msg_len, sink, user_data, msg_len );
 
-  } else {
+  if ( ret != ISU_DTE_OK ) {
     LOG_DBG( "Could not get MT message (%03d) -> (%03d)", 
       ret, isu_dte_get_err( ISBD_DTE ) );
   }
 
-  return false;
+  return ret == ISU_DTE_OK;
 }
 
 static inline void _notify_err( isbd_err_t err ) {
@@ -108,11 +102,19 @@ static inline void _notify_mo_msg( struct isbd_mo_msg *mo_msg ) {
 
 }
 
+/**
+ * @brief Checks if the given MO message has a payload, 
+ * otherwise it is just a session request
+ */
+static inline bool _mo_msg_has_payload( struct isbd_mo_msg *mo_msg ) {
+  return mo_msg->len > 0 && ( mo_msg->data || mo_msg->producer );
+}
+
 static inline void _handle_session_mo_msg( 
   isu_session_ext_t *session, struct isbd_mo_msg *mo_msg 
 ) {
 
-  if ( mo_msg->data && mo_msg->len > 0 ) {
+  if ( _mo_msg_has_payload( mo_msg ) ) {
     
     if ( session->mo_sts < 3 ) {
     
@@ -141,34 +143,44 @@ static inline void _handle_session_mt_msg(
   
   if ( session->mt_sts == 1 ) {
 
-    struct isbd_mt_msg mt_msg;
+    struct isbd_mt_msg mt_msg = {
+      .sn = session->mt_msn,
+      .len = session->mt_len,
+      .data = NULL,
+    };
 
-    mt_msg.sn = session->mt_msn;
-    mt_msg.len = session->mt_len;
-    mt_msg.data = (uint8_t*) k_malloc( sizeof( uint8_t ) * session->mt_len );
-    
-    if ( mt_msg.data ) {
+    isu_mt_sink_t sink = g_isbd.cnf.mt_sink;
+    void *user_data = g_isbd.cnf.mt_user_data;
+
+    if ( sink == NULL ) {
+
+      mt_msg.data = (uint8_t*) k_malloc( sizeof( uint8_t ) * session->mt_len );
 
-      LOG_DBG( "Reading MT message, len=%hu", mt_msg.len );
+      if ( mt_msg.data == NULL ) {
+        LOG_ERR( "%s", "Could not alloc memory for MT message" );
+        // TODO: the message still remains in the ISU memory, try again later ?
+        return;
+      }
 
-      bool msg_read = 
-        _read_mt_msg( mt_msg.data, &mt_msg.len );
+      sink = isu_mt_copy_sink;
+      user_data = mt_msg.data;
+    }
 
-      if ( msg_read ) {
-        _notify_mt_msg( &mt_msg );
+    LOG_DBG( "Reading MT message, len=%hu", mt_msg.len );
 
-        if ( session->mt_queued > 0 ) {
-          isbd_request_session( false );
-        }
+    bool msg_read = 
+      _read_mt_msg( &mt_msg.len, sink, user_data );
 
-      } else {
-        _notify_err( ISBD_ERR_MT );
-        isbd_destroy_mt_msg( &mt_msg );
+    if ( msg_read ) {
+      _notify_mt_msg( &mt_msg );
+
+      if ( session->mt_queued > 0 ) {
+        isbd_request_session( false );
       }
 
     } else {
-      LOG_ERR( "%s", "Could not alloc memory for MT message" );
-      // TODO: the message still remains in the ISU memory, try again later ?
+      _notify_err( ISBD_ERR_MT );
+      isbd_destroy_mt_msg( &mt_msg );
     }
 
   }
@@ -179,10 +191,16 @@ void _init_session( struct isbd_mo_msg *mo_msg ) {
 
   isu_dte_err_t ret;
 
-  if ( mo_msg->data && mo_msg->len > 0 ) {
+  if ( _mo_msg_has_payload( mo_msg ) ) {
     
     LOG_DBG( "Setting MO buffer, len=%hu", mo_msg->len );
-    ret = isu_set_mo( ISBD_DTE, mo_msg->data, mo_msg->len );
+
+    if ( mo_msg->data ) {
+      ret = isu_set_mo( ISBD_DTE, mo_msg->data, mo_msg->len );
+    } else {
+      ret = isu_set_mo_stream( 
+        ISBD_DTE, mo_msg->len, mo_msg->producer, mo_msg->user_data );
+    }
 
     if ( ret != ISU_DTE_OK ) {
       isbd_destroy_mo_msg( mo_msg );
@@ -199,9 +217,6 @@ void _init_session( struct isbd_mo_msg *mo_msg ) {
     isu_session_ext_t session;
     ret = isu_init_session( ISBD_DTE, &session, mo_msg->alert );
 
-    // Fixes: https://glab.lromeraj.net/ucm/miot/tfm/iridium-sbd-library/-/issues/27
-    _wait_for_dte_events( 10 );
-
     if ( ret == ISU_DTE_OK ) {
       _handle_session_mo_msg( &session, mo_msg );
       _handle_session_mt_msg( &session );
@@ -218,6 +233,7 @@ isbd_err_t isbd_destroy_mt_msg( struct isbd_mt_msg *mt_msg ) {
   if ( mt_msg->data ) {
     k_free( mt_msg->data );
   }
+  mt_msg->data = NULL;
   mt_msg->len = 0;
 
   return ISBD_OK;
@@ -234,27 +250,41 @@ void _entry_point( void *v1, void *v2, void *v3 ) {
   isu_dte_err_t dte_err;
   
 
-  dte_err = isu_set_evt_report(
-    ISBD_DTE, &evt_report, &g_isbd.sigq, &g_isbd.svca );
+  // ! Both settings are applied using a single command line,
+  // ! individual commands are used if it fails
+  dte_err = isu_set_evt_report_mt_alert(
+    ISBD_DTE, &evt_report, ISU_MT_ALERT_ENABLED, &g_isbd.sigq, &g_isbd.svca );
 
   if ( dte_err == ISU_DTE_OK ) {
     LOG_DBG( "svca=%hhu, sigq=%hhu", g_isbd.svca, g_isbd.sigq );
+    LOG_INF( "%s", "Ring alerts enabled" );
   } else {
-    LOG_ERR( "%s", "Could not set event reporting" );
-  }
+    
+    dte_err = isu_set_evt_report(
+      ISBD_DTE, &evt_report, &g_isbd.sigq, &g_isbd.svca );
 
-  dte_err = isu_set_mt_alert( ISBD_DTE, ISU_MT_ALERT_ENABLED );
+    if ( dte_err == ISU_DTE_OK ) {
+      LOG_DBG( "svca=%hhu, sigq=%hhu", g_isbd.svca, g_isbd.sigq );
+    } else {
+      LOG_ERR( "%s", "Could not set event reporting" );
+    }
 
-  if ( dte_err == ISU_DTE_OK ) {
-    LOG_INF( "%s", "Ring alerts enabled" );
-  } else {
-    LOG_ERR( "%s", "Could not enable ring alerts" );
+    dte_err = isu_set_mt_alert( ISBD_DTE, ISU_MT_ALERT_ENABLED );
+
+    if ( dte_err == ISU_DTE_OK ) {
+      LOG_INF( "%s", "Ring alerts enabled" );
+    } else {
+      LOG_ERR( "%s", "Could not enable ring alerts" );
+    }
   }
 
   DO_FOREVER {
 
     struct isbd_mo_msg mo_msg;
 
+    // submitted commands are executed between sessions
+    while ( isu_dte_cmd_process( ISBD_DTE, K_NO_WAIT ) );
+
     // sessions will be sent only if the service is currently available
     if ( g_isbd.svca && g_isbd.sigq >= g_isbd.cnf.sigq_threshold ) {
       if ( k_msgq_get( ISBD_MO_Q, &mo_msg, K_NO_WAIT ) == 0 ) {
@@ -269,13 +299,16 @@ void _entry_point( void *v1, void *v2, void *v3 ) {
 
 static void _wait_for_dte_events( uint32_t timeout_ms ) {
 
-  isu_dte_err_t dte_err;
   isu_dte_evt_t dte_evt;
 
-  dte_err = isu_dte_evt_wait(
-    ISBD_DTE, &dte_evt, timeout_ms );
-
-  if ( dte_err == ISU_DTE_OK ) {
+  // ! Events received during sessions (or any other command) are queued
+  // ! by the DTE, so all of them are processed here
+  while ( 
+#ifdef CONFIG_POLL
+    // submitted commands wake the thread up, see isu_dte_cmd_submit()
+    isu_dte_poll( ISBD_DTE, K_MSEC( timeout_ms ) ) &&
+#endif
+    isu_dte_evt_wait( ISBD_DTE, &dte_evt, timeout_ms ) == ISU_DTE_OK ) {
 
     isbd_evt_t isbd_evt = {
       .id = ISBD_EVT_UNK,
@@ -295,10 +328,8 @@ static void _wait_for_dte_events( uint32_t timeout_ms ) {
 
     k_msgq_put( ISBD_EVT_Q, &isbd_evt, K_NO_WAIT );
 
-    // ! If there is more than one event in the reception buffer
-    // ! we have to wait a little for it to avoid a possible event loss
-    _wait_for_dte_events( 10 );
-
+    // remaining events are processed without waiting
+    timeout_ms = 0;
   }
 
 
@@ -312,6 +343,7 @@ isbd_err_t isbd_destroy_mo_msg( struct isbd_mo_msg *mo_msg ) {
 
   mo_msg->len = 0;
   mo_msg->data = NULL;
+  mo_msg->producer = NULL;
 
   return ISBD_OK;
 }
@@ -347,23 +379,11 @@ isbd_err_t _enqueue_mo_msg( struct isbd_mo_msg *mo_msg ) {
   return ISBD_ERR_SPACE;
 }
 
-isbd_err_t isbd_send_mo_msg( 
-  const uint8_t *msg, uint16_t msg_len, uint8_t retries 
-) {
-
-  struct isbd_mo_msg mo_msg;
-  
-  mo_msg.len = msg_len;
-  mo_msg.alert = false;
-  mo_msg.retries = retries;
-
-  mo_msg.data = (uint8_t*)k_malloc( sizeof(uint8_t) * msg_len );
-  
-  if ( mo_msg.data == NULL ) {
-    return ISBD_ERR_MEM;
-  } else {
-    memcpy( mo_msg.data, msg, msg_len );
-  }
+/**
+ * @brief Enqueues an MO message with payload, a pending 
+ * session request is merged into the message
+ */
+static isbd_err_t _send_mo_msg( struct isbd_mo_msg *mo_msg ) {
 
   // TODO: instead of doing this we could use a global flag
   // TODO: but we'll need extra synchronization mechanism 
@@ -372,11 +392,11 @@ isbd_err_t isbd_send_mo_msg(
     struct isbd_mo_msg _mo_msg;
     if ( k_msgq_get( ISBD_MO_Q, &_mo_msg, K_NO_WAIT ) == 0 ) {
 
-      if ( _mo_msg.data == NULL ) { 
+      if ( !_mo_msg_has_payload( &_mo_msg ) ) { 
         // empty payload, so it's a simple session request
         
         // copy alert flag from the queued message to the current message
-        mo_msg.alert = _mo_msg.alert;
+        mo_msg->alert = _mo_msg.alert;
 
         // ar there is no payload this is not mandatory, but recommended
         isbd_destroy_mo_msg( &_mo_msg );
@@ -390,16 +410,56 @@ isbd_err_t isbd_send_mo_msg(
 
   }
 
-  return _enqueue_mo_msg( &mo_msg );
+  return _enqueue_mo_msg( mo_msg );
 }
 
-isbd_err_t isbd_request_session( bool alert ) {
+isbd_err_t isbd_send_mo_msg( 
+  const uint8_t *msg, uint16_t msg_len, uint8_t retries 
+) {
+
+  struct isbd_mo_msg mo_msg = {
+    .len = msg_len,
+    .alert = false,
+    .retries = retries,
+  };
 
-  struct isbd_mo_msg mo_msg;
+  mo_msg.data = (uint8_t*)k_malloc( sizeof(uint8_t) * msg_len );
   
-  mo_msg.len = 0;
-  mo_msg.data = NULL;
-  mo_msg.alert = alert;
+  if ( mo_msg.data == NULL ) {
+    return ISBD_ERR_MEM;
+  } else {
+    memcpy( mo_msg.data, msg, msg_len );
+  }
+
+  return _send_mo_msg( &mo_msg );
+}
+
+isbd_err_t isbd_send_mo_stream( 
+  uint16_t msg_len, isu_mo_producer_t producer, void *user_data, uint8_t retries 
+) {
+
+  if ( producer == NULL || msg_len == 0 ) {
+    return ISBD_ERR_UNK;
+  }
+
+  struct isbd_mo_msg mo_msg = {
+    .len = msg_len,
+    .alert = false,
+    .retries = retries,
+    .producer = producer,
+    .user_data = user_data,
+  };
+
+  return _send_mo_msg( &mo_msg );
+}
+
+isbd_err_t isbd_request_session( bool alert ) {
+
+  struct isbd_mo_msg mo_msg = {
+    .len = 0,
+    .data = NULL,
+    .alert = alert,
+  };
 
   // if the queue already has pending session requests
   // there is no need to push a new one
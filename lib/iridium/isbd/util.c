@@ -1,9 +1,168 @@
+#include <string.h>
+
+#if defined( __ARM_FEATURE_SIMD32 )
+  #include <arm_acle.h>
+#endif
+
 #include "isbd/util.h"
 
-uint16_t isbd_util_compute_checksum( const uint8_t *msg_buf, uint16_t msg_buf_len ) {
+/**
+ * @brief Number of words added per iteration of the word kernels
+ */
+#define SUM_UNROLL              4
+
+/**
+ * @brief Every 16-bit lane of the SWAR accumulators gets at most 
+ * 0xFF per word, so they can take 257 words before overflowing
+ */
+#define SWAR_FLUSH_WORDS        256
+
+#define SWAR_LANE_MASK          0x00FF00FF
+
+static inline uint32_t _load_word( const uint8_t *buf ) {
+  uint32_t word;
+  // the buffer is aligned, so this is a single load
+  memcpy( &word, buf, sizeof( word ) );
+  return word;
+}
+
+/**
+ * @brief Adds the unaligned head of the buffer byte by byte
+ * 
+ * @return uint16_t Number of bytes added
+ */
+static inline uint16_t _sum_head( const uint8_t *buf, uint16_t len, uint32_t *sum ) {
+
+  uint16_t head = ( -(uintptr_t) buf ) & ( sizeof( uint32_t ) - 1 );
+  
+  if ( head > len ) {
+    head = len;
+  }
+
+  *sum += isbd_util_sum_ref( buf, head );
+
+  return head;
+}
+
+uint32_t isbd_util_sum_ref( const uint8_t *buf, uint16_t len ) {
   uint32_t sum = 0;
-  for ( uint16_t i = 0; i < msg_buf_len; i++ ) {
-    sum += msg_buf[ i ];
+  for ( uint16_t i = 0; i < len; i++ ) {
+    sum += buf[ i ];
   }  
-  return (sum & 0xFFFF);
+  return sum;
+}
+
+uint32_t isbd_util_sum_swar( const uint8_t *buf, uint16_t len ) {
+
+  uint32_t sum = 0;
+  uint16_t head = _sum_head( buf, len, &sum );
+
+  buf += head;
+  len -= head;
+
+  uint16_t words = len / sizeof( uint32_t );
+
+  while ( words > 0 ) {
+
+    uint16_t block = words < SWAR_FLUSH_WORDS ? words : SWAR_FLUSH_WORDS;
+    uint16_t i = 0;
+
+    // even and odd bytes are added into two independent 
+    // accumulators of two 16-bit lanes each
+    uint32_t acc_even = 0;
+    uint32_t acc_odd = 0;
+
+    for ( ; i + SUM_UNROLL <= block; i += SUM_UNROLL ) {
+      
+      uint32_t w0 = _load_word( buf );
+      uint32_t w1 = _load_word( buf + 4 );
+      uint32_t w2 = _load_word( buf + 8 );
+      uint32_t w3 = _load_word( buf + 12 );
+
+      acc_even += ( w0 & SWAR_LANE_MASK ) + ( w1 & SWAR_LANE_MASK ) 
+        + ( w2 & SWAR_LANE_MASK ) + ( w3 & SWAR_LANE_MASK );
+
+      acc_odd += ( ( w0 >> 8 ) & SWAR_LANE_MASK ) + ( ( w1 >> 8 ) & SWAR_LANE_MASK )
+        + ( ( w2 >> 8 ) & SWAR_LANE_MASK ) + ( ( w3 >> 8 ) & SWAR_LANE_MASK );
+
+      buf += SUM_UNROLL * sizeof( uint32_t );
+    }
+
+    for ( ; i < block; i++ ) {
+      uint32_t w = _load_word( buf );
+      acc_even += w & SWAR_LANE_MASK;
+      acc_odd += ( w >> 8 ) & SWAR_LANE_MASK;
+      buf += sizeof( uint32_t );
+    }
+
+    sum += ( acc_even & 0xFFFF ) + ( acc_even >> 16 )
+      + ( acc_odd & 0xFFFF ) + ( acc_odd >> 16 );
+
+    words -= block;
+  }
+
+  return sum + isbd_util_sum_ref( buf, len & ( sizeof( uint32_t ) - 1 ) );
+}
+
+#if defined( __ARM_FEATURE_SIMD32 )
+
+uint32_t isbd_util_sum_simd32( const uint8_t *buf, uint16_t len ) {
+
+  uint32_t sum = 0;
+  uint16_t head = _sum_head( buf, len, &sum );
+
+  buf += head;
+  len -= head;
+
+  uint16_t words = len / sizeof( uint32_t );
+  uint16_t i = 0;
+
+  // USADA8 adds the absolute differences of the four bytes against zero,
+  // that is the sum of the bytes, there is no lane overflow to care about
+  uint32_t acc0 = 0;
+  uint32_t acc1 = 0;
+
+  for ( ; i + SUM_UNROLL <= words; i += SUM_UNROLL ) {
+    acc0 = __usada8( _load_word( buf ), 0, acc0 );
+    acc1 = __usada8( _load_word( buf + 4 ), 0, acc1 );
+    acc0 = __usada8( _load_word( buf + 8 ), 0, acc0 );
+    acc1 = __usada8( _load_word( buf + 12 ), 0, acc1 );
+    buf += SUM_UNROLL * sizeof( uint32_t );
+  }
+
+  for ( ; i < words; i++ ) {
+    acc0 = __usada8( _load_word( buf ), 0, acc0 );
+    buf += sizeof( uint32_t );
+  }
+
+  return sum + acc0 + acc1 
+    + isbd_util_sum_ref( buf, len & ( sizeof( uint32_t ) - 1 ) );
+}
+
+#endif
+
+void isbd_util_csum_init( isbd_util_csum_t *csum ) {
+  csum->sum = 0;
+}
+
+void isbd_util_csum_update( isbd_util_csum_t *csum, const uint8_t *buf, uint16_t len ) {
+#if defined( __ARM_FEATURE_SIMD32 )
+  csum->sum += isbd_util_sum_simd32( buf, len );
+#else
+  csum->sum += isbd_util_sum_swar( buf, len );
+#endif
+}
+
+uint16_t isbd_util_csum_final( const isbd_util_csum_t *csum ) {
+  return (csum->sum & 0xFFFF);
+}
+
+uint16_t isbd_util_compute_checksum( const uint8_t *msg_buf, uint16_t msg_buf_len ) {
+
+  isbd_util_csum_t csum;
+
+  isbd_util_csum_init( &csum );
+  isbd_util_csum_update( &csum, msg_buf, msg_buf_len );
+
+  return isbd_util_csum_final( &csum );
 }
@@ -18,10 +18,6 @@
 
 LOG_MODULE_REGISTER( isu );
 
-// codes prefixed with v means verbose version of the same code
-#define VCODE_READY_STR        "READY"
-#define CODE_READY_STR          VCODE_READY_STR
-
 /**
  * @brief Short timeout for commands which usually take
  * less than 1 second, for example: AT+CGSN
@@ -34,19 +30,96 @@ LOG_MODULE_REGISTER( isu );
  */
 #define LONG_TIMEOUT_RESPONSE       (60 * 1000) // ms
 
+/**
+ * @brief Size of the chunks requested to MO message producers,
+ * see isu_set_mo_stream()
+ */
+#define MO_STREAM_CHUNK_SIZE        32
+
 #define SEND_TINY_CMD_OR_RET( dte, at_cmd_tmpl, ... ) \
   do { \
     int M_err = isu_dte_send_tiny_cmd( dte, at_cmd_tmpl, __VA_ARGS__ ); \
     if ( M_err != ISU_DTE_OK ) { return M_err; } \
   } while( 0 );
 
+/**
+ * @brief Sends a constant command, the string and its length
+ * are computed at compile time, for example: "+CSQ"
+ */
+#define SEND_CONST_CMD_OR_RET( dte, cmd ) \
+  do { \
+    int M_err = isu_dte_write_cmd( dte, AT_CMD( cmd ), AT_CMD_LEN( AT_CMD( cmd ) ) ); \
+    if ( M_err != ISU_DTE_OK ) { return M_err; } \
+  } while( 0 );
+
+/**
+ * @brief Sends a command with a trailing integer parameter, 
+ * for example: SEND_INT_CMD_OR_RET( dte, "+SBDWB=", len )
+ */
+#define SEND_INT_CMD_OR_RET( dte, cmd, value ) \
+  do { \
+    int M_err = isu_dte_send_int_cmd( \
+      dte, AT_STR cmd, AT_CMD_LEN( AT_STR cmd ), value ); \
+    if ( M_err != ISU_DTE_OK ) { return M_err; } \
+  } while( 0 );
+
+/**
+ * @brief Maximum length of a mobile terminated message, 
+ * received lengths above this value are not valid
+ */
+#define MT_MAX_LEN                  270
+
+/**
+ * @brief State of a binary response being unpacked, see _unpack_bin_resp()
+ */
+typedef struct mt_stream {
+  isu_mt_sink_t sink;
+  void *user_data;
+  uint16_t offset;
+  isbd_util_csum_t csum; // computed on the fly
+} mt_stream_t;
+
+/**
+ * @brief Source of a mobile originated message, see _set_mo()
+ */
+typedef struct mo_source {
+  const uint8_t *msg; // contiguous message, NULL if the producer is used
+  isu_mo_producer_t producer;
+  void *user_data; // passed to the producer
+  bool failed; // the producer could not produce the whole message
+} mo_source_t;
+
+/**
+ * @brief Writes a mobile originated message followed by its checksum,
+ * once the ISU is ready to receive it
+ */
+static at_uart_err_t _mo_write( isu_dte_t *dte, mo_source_t *src, uint16_t msg_len );
+
+/**
+ * @brief Writes a mobile originated message using AT+SBDWB, 
+ * shared by isu_set_mo() and isu_set_mo_stream()
+ */
+static isu_dte_err_t _set_mo( isu_dte_t *dte, mo_source_t *src, uint16_t msg_len );
+
 static at_uart_err_t _unpack_bin_resp(
-  isu_dte_t *dte, uint8_t *msg_buf, uint16_t *msg_buf_len, uint16_t *csum, uint16_t timeout_ms 
+  isu_dte_t *dte, mt_stream_t *stream, uint16_t max_len,
+  uint16_t *msg_len, uint16_t *csum, uint16_t timeout_ms 
 );
 
-isu_dte_err_t isu_get_imei( isu_dte_t *dte, char *imei_buf, size_t imei_buf_len ) {
+/**
+ * @brief Sets indicator event reporting, optionally followed 
+ * by the ring alert option in the same command line
+ * 
+ * @param alert Ring alert option, NULL to leave it unchanged
+ */
+static isu_dte_err_t _set_evt_report( 
+  isu_dte_t *dte, isu_evt_report_t *evt_report, const isu_mt_alert_t *alert,
+  uint8_t *sigq, uint8_t *svca
+);
+
+static isu_dte_err_t _get_imei( isu_dte_t *dte, char *imei_buf, size_t imei_buf_len ) {
   
-  SEND_TINY_CMD_OR_RET( dte, AT_CMD_TMPL_EXEC, "+CGSN" );
+  SEND_CONST_CMD_OR_RET( dte, "+CGSN" );
 
   dte->err = at_uart_parse_resp(
     &dte->at_uart, imei_buf, imei_buf_len, AT_2_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
@@ -54,9 +127,9 @@ isu_dte_err_t isu_get_imei( isu_dte_t *dte, char *imei_buf, size_t imei_buf_len
   return dte->err == AT_UART_OK ? ISU_DTE_OK : ISU_DTE_ERR_AT; 
 }
 
-isu_dte_err_t isu_get_revision( isu_dte_t *dte, char *rev_buf, size_t rev_buf_len ) {
+static isu_dte_err_t _get_revision( isu_dte_t *dte, char *rev_buf, size_t rev_buf_len ) {
   
-  SEND_TINY_CMD_OR_RET( dte,  AT_CMD_TMPL_EXEC, "+CGMR" );
+  SEND_CONST_CMD_OR_RET( dte, "+CGMR" );
 
   dte->err = at_uart_parse_resp( 
     &dte->at_uart, rev_buf, rev_buf_len, AT_UNK_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
@@ -64,9 +137,133 @@ isu_dte_err_t isu_get_revision( isu_dte_t *dte, char *rev_buf, size_t rev_buf_le
   return dte->err == AT_UART_OK ? ISU_DTE_OK : ISU_DTE_ERR_AT;
 }
 
+#ifdef CONFIG_ISU_DTE_IDENTITY_CACHE
+
+/**
+ * @brief Fills the given cache entry if it is empty
+ */
+static isu_dte_err_t _identity_fill( 
+  isu_dte_t *dte, char *entry, size_t entry_size,
+  isu_dte_err_t (*query)( isu_dte_t*, char*, size_t )
+) {
+
+  if ( entry[ 0 ] != '\0' ) {
+    return ISU_DTE_OK;
+  }
+
+  isu_dte_err_t ret = query( dte, entry, entry_size );
+
+  if ( ret != ISU_DTE_OK ) {
+    // partial responses must not be served later
+    entry[ 0 ] = '\0';
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Copies a cache entry to the caller buffer, 
+ * errors are reported as if the ISU was queried
+ */
+static isu_dte_err_t _identity_copy( 
+  isu_dte_t *dte, const char *entry, char *buf, size_t buf_len 
+) {
+
+  size_t len = strlen( entry );
+
+  if ( len >= buf_len ) {
+    dte->err = AT_UART_OVERFLOW;
+    return ISU_DTE_ERR_AT;
+  }
+
+  memcpy( buf, entry, len + 1 );
+  dte->err = AT_UART_OK;
+
+  return ISU_DTE_OK;
+}
+
+#endif
+
+isu_dte_err_t isu_get_imei( isu_dte_t *dte, char *imei_buf, size_t imei_buf_len ) {
+
+#ifdef CONFIG_ISU_DTE_IDENTITY_CACHE
+  
+  isu_dte_err_t ret = _identity_fill( 
+    dte, dte->identity.imei, sizeof( dte->identity.imei ), _get_imei );
+
+  return ret == ISU_DTE_OK
+    ? _identity_copy( dte, dte->identity.imei, imei_buf, imei_buf_len )
+    : ret;
+
+#else
+  return _get_imei( dte, imei_buf, imei_buf_len );
+#endif
+
+}
+
+isu_dte_err_t isu_get_revision( isu_dte_t *dte, char *rev_buf, size_t rev_buf_len ) {
+
+#ifdef CONFIG_ISU_DTE_IDENTITY_CACHE
+  
+  isu_dte_err_t ret = _identity_fill( 
+    dte, dte->identity.revision, sizeof( dte->identity.revision ), _get_revision );
+
+  return ret == ISU_DTE_OK
+    ? _identity_copy( dte, dte->identity.revision, rev_buf, rev_buf_len )
+    : ret;
+
+#else
+  return _get_revision( dte, rev_buf, rev_buf_len );
+#endif
+
+}
+
+isu_dte_err_t isu_get_revision_stream( 
+  isu_dte_t *dte, at_uart_resp_cb_t cb, void *user_data 
+) {
+
+#ifdef CONFIG_ISU_DTE_IDENTITY_CACHE
+
+  isu_dte_err_t ret = _identity_fill( 
+    dte, dte->identity.revision, sizeof( dte->identity.revision ), _get_revision );
+
+  if ( ret != ISU_DTE_OK ) {
+    return ret;
+  }
+
+  // cached lines are split by \n, see at_uart_parse_resp()
+  const char *line = dte->identity.revision;
+
+  while ( *line != '\0' ) {
+
+    const char *line_end = strchr( line, '\n' );
+    uint16_t len = line_end ? line_end - line : strlen( line );
+
+    if ( len > 0 ) {
+      cb( &dte->at_uart, line, len, true, user_data );
+    }
+
+    line += line_end ? len + 1 : len;
+  }
+
+  return ISU_DTE_OK;
+
+#else
+
+  SEND_CONST_CMD_OR_RET( dte, "+CGMR" );
+
+  dte->err = at_uart_stream_resp( 
+    &dte->at_uart, cb, user_data, AT_UNK_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
+
+  return dte->err == AT_UART_OK ? ISU_DTE_OK : ISU_DTE_ERR_AT;
+
+#endif
+
+}
+
 isu_dte_err_t isu_get_rtc( isu_dte_t *dte, char *rtc_buf, size_t rtc_buf_len ) {
   
-  SEND_TINY_CMD_OR_RET( dte, AT_CMD_TMPL_EXEC, "+CCLK" );
+  SEND_CONST_CMD_OR_RET( dte, "+CCLK" );
 
   dte->err = at_uart_parse_resp( 
     &dte->at_uart, rtc_buf, rtc_buf_len, AT_2_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
@@ -77,8 +274,11 @@ isu_dte_err_t isu_get_rtc( isu_dte_t *dte, char *rtc_buf, size_t rtc_buf_len ) {
 // TODO: this should be named isbd_init_session_ext()
 isu_dte_err_t isu_init_session( isu_dte_t *dte, isu_session_ext_t *session, bool alert ) {
   
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_EXEC_STR, "+SBDIX", alert ? "A" : "" );
+  if ( alert ) {
+    SEND_CONST_CMD_OR_RET( dte, "+SBDIXA" );
+  } else {
+    SEND_CONST_CMD_OR_RET( dte, "+SBDIX" );
+  }
 
   char buf[ 64 ];
   dte->err = at_uart_parse_resp(
@@ -88,16 +288,25 @@ isu_dte_err_t isu_init_session( isu_dte_t *dte, isu_session_ext_t *session, bool
 
   if ( dte->err == AT_UART_OK ) {
     
-    // TODO: implement optimized function instead of using sscanf
-    int read = sscanf( buf, "+SBDIX:%hhu,%hu,%hhu,%hu,%hu,%hhu",
-      &session->mo_sts,
-      &session->mo_msn,
-      &session->mt_sts,
-      &session->mt_msn,
-      &session->mt_len,
-      &session->mt_queued );
+    // MO status, MOMSN, MT status, MTMSN, MT length, MT queued
+    static const uint16_t max[] = { 
+      UINT8_MAX, UINT16_MAX, UINT8_MAX, UINT16_MAX, UINT16_MAX, UINT8_MAX };
+    
+    uint16_t fields[ ARRAY_SIZE( max ) ];
+
+    if ( at_parse_uints( buf, "+SBDIX:", fields, max, ARRAY_SIZE( max ) ) 
+        != ARRAY_SIZE( max ) ) {
+      return ISU_DTE_ERR_UNK;
+    }
+
+    session->mo_sts = fields[ 0 ];
+    session->mo_msn = fields[ 1 ];
+    session->mt_sts = fields[ 2 ];
+    session->mt_msn = fields[ 3 ];
+    session->mt_len = fields[ 4 ];
+    session->mt_queued = fields[ 5 ];
     
-    return read == 6 ? ISU_DTE_OK : ISU_DTE_ERR_UNK;
+    return ISU_DTE_OK;
 
   } else {
     return ISU_DTE_ERR_AT;
@@ -107,7 +316,7 @@ isu_dte_err_t isu_init_session( isu_dte_t *dte, isu_session_ext_t *session, bool
 
 isu_dte_err_t isu_clear_buffer( isu_dte_t *dte, isu_clear_buffer_t buffer ) {
 
-  SEND_TINY_CMD_OR_RET( dte, AT_CMD_TMPL_EXEC_INT, "+SBDD", buffer );
+  SEND_INT_CMD_OR_RET( dte, "+SBDD", buffer );
 
   int err;
   uint8_t code;
@@ -162,10 +371,85 @@ isu_dte_err_t isu_set_mo_txt( isu_dte_t *dte, const char *txt ) {
   return dte->err == AT_UART_OK ? ISU_DTE_OK : ISU_DTE_ERR_AT;
 }
 
-isu_dte_err_t isu_set_mo( isu_dte_t *dte, const uint8_t *msg_buf, uint16_t msg_buf_len ) {
+static at_uart_err_t _mo_write( isu_dte_t *dte, mo_source_t *src, uint16_t msg_len ) {
 
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_SET_INT, "+SBDWB", msg_buf_len );
+  uint8_t csum_buf[ 2 ];
+
+  if ( src->msg ) {
+
+    *( (uint16_t*)&csum_buf[ 0 ] ) = 
+      htons( isbd_util_compute_checksum( src->msg, msg_len ) );
+
+    // MSG (N bytes) + CHECKSUM (2 bytes) in a single transfer
+    zuart_iovec_t iov[] = {
+      { .buf = src->msg, .len = msg_len },
+      { .buf = csum_buf, .len = sizeof( csum_buf ) },
+    };
+
+    return at_uart_writev( 
+      &dte->at_uart, iov, ARRAY_SIZE( iov ), NULL, SHORT_TIMEOUT_RESPONSE );
+  }
+
+  uint8_t chunk[ MO_STREAM_CHUNK_SIZE ];
+  uint16_t offset = 0;
+  isbd_util_csum_t csum;
+
+  isbd_util_csum_init( &csum );
+
+  // the ISU does not send anything until it receives the whole message,
+  // so the message is written as it is produced
+  do {
+
+    uint16_t size = MIN( sizeof( chunk ), msg_len - offset );
+    uint16_t len = src->failed 
+      ? 0 
+      : src->producer( chunk, offset, size, src->user_data );
+
+    if ( len < size ) {
+      // ! The ISU waits for the announced length, the remaining 
+      // ! bytes are padded and the checksum is inverted below
+      memset( &chunk[ len ], 0, size - len );
+      src->failed = true;
+    }
+
+    isbd_util_csum_update( &csum, chunk, size );
+
+    offset += size;
+
+    zuart_iovec_t iov[] = {
+      { .buf = chunk, .len = size },
+      { .buf = csum_buf, .len = 0 },
+    };
+
+    // the last chunk is written along with the checksum
+    if ( offset == msg_len ) {
+
+      uint16_t msg_csum = isbd_util_csum_final( &csum );
+
+      if ( src->failed ) {
+        LOG_ERR( "%s", "MO message could not be produced" );
+        msg_csum = ~msg_csum;
+      }
+
+      *( (uint16_t*)&csum_buf[ 0 ] ) = htons( msg_csum );
+      iov[ 1 ].len = sizeof( csum_buf );
+    }
+
+    at_uart_err_t at_err = at_uart_writev( 
+      &dte->at_uart, iov, ARRAY_SIZE( iov ), NULL, SHORT_TIMEOUT_RESPONSE );
+
+    if ( at_err != AT_UART_OK ) {
+      return at_err;
+    }
+
+  } while ( offset < msg_len );
+
+  return AT_UART_OK;
+}
+
+static isu_dte_err_t _set_mo( isu_dte_t *dte, mo_source_t *src, uint16_t msg_len ) {
+
+  SEND_INT_CMD_OR_RET( dte, "+SBDWB=", msg_len );
   
   // After the initial AT+SBDWB command
   // the ISU should answer with a READY string
@@ -181,20 +465,15 @@ isu_dte_err_t isu_set_mo( isu_dte_t *dte, const uint8_t *msg_buf, uint16_t msg_b
     &dte->at_uart, str_code, sizeof( str_code ), &code, SHORT_TIMEOUT_RESPONSE );
 
   if ( at_err == AT_UART_UNK 
-      && streq( str_code, CODE_READY_STR ) ) {
-      
-    uint8_t csum_buf[ 2 ];
-
-    *( (uint16_t*)&csum_buf[ 0 ] ) = 
-      htons( isbd_util_compute_checksum( msg_buf, msg_buf_len ) );
+      && at_uart_get_code( &dte->at_uart ) == AT_CODE_READY ) {
 
     // finally write binary data to the ISU
-    // MSG (N bytes) + CHECKSUM (2 bytes)
-    at_uart_write( // TODO: if write fails return immediately
-      &dte->at_uart, msg_buf, msg_buf_len, SHORT_TIMEOUT_RESPONSE );
+    at_err = _mo_write( dte, src, msg_len );
 
-    at_uart_write( // TODO: if write fails return immediately
-      &dte->at_uart, csum_buf, sizeof( csum_buf ), SHORT_TIMEOUT_RESPONSE );
+    if ( at_err != AT_UART_OK ) {
+      dte->err = at_err;
+      return ISU_DTE_ERR_AT;
+    }
 
     // Due to AT nature it is not strictly necessary to check this result.
     // This is will be done in the last call of at_uart_skip_resp()
@@ -207,23 +486,61 @@ isu_dte_err_t isu_set_mo( isu_dte_t *dte, const uint8_t *msg_buf, uint16_t msg_b
   at_err = at_uart_skip_resp(
     &dte->at_uart, AT_1_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
 
-  if ( at_err == AT_UART_OK ) {
-    dte->err = code;
-    return code == 0 ? ISU_DTE_OK : ISU_DTE_ERR_CMD;
-  } else {
+  if ( at_err != AT_UART_OK ) {
     dte->err = at_err;
     return ISU_DTE_ERR_AT;
   }
 
+  dte->err = code;
+
+  // the ISU rejects the message due to the inverted checksum
+  if ( src->failed ) {
+    return ISU_DTE_ERR_PRODUCER;
+  }
+
+  return code == 0 ? ISU_DTE_OK : ISU_DTE_ERR_CMD;
+}
+
+isu_dte_err_t isu_set_mo( isu_dte_t *dte, const uint8_t *msg_buf, uint16_t msg_buf_len ) {
+
+  mo_source_t src = {
+    .msg = msg_buf,
+  };
+
+  return _set_mo( dte, &src, msg_buf_len );
+}
+
+isu_dte_err_t isu_set_mo_stream( 
+  isu_dte_t *dte, uint16_t msg_len, isu_mo_producer_t producer, void *user_data
+) {
+
+  mo_source_t src = {
+    .producer = producer,
+    .user_data = user_data,
+  };
+
+  return _set_mo( dte, &src, msg_len );
+}
+
+void isu_mt_copy_sink( 
+  const uint8_t *chunk, uint16_t offset, uint16_t len, void *user_data 
+) {
+  memcpy( (uint8_t*) user_data + offset, chunk, len );
 }
 
 isu_dte_err_t isu_get_mt( isu_dte_t *dte, uint8_t *msg, uint16_t *msg_len, uint16_t *csum ) {
   
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_EXEC, "+SBDRB" );
+  SEND_CONST_CMD_OR_RET( dte, "+SBDRB" );
+
+  mt_stream_t stream = {
+    .sink = isu_mt_copy_sink,
+    .user_data = msg,
+  };
+
+  isbd_util_csum_init( &stream.csum );
 
   dte->err = _unpack_bin_resp(
-    dte, msg, msg_len, csum, SHORT_TIMEOUT_RESPONSE );
+    dte, &stream, *msg_len, msg_len, csum, SHORT_TIMEOUT_RESPONSE );
   
   if ( dte->err == AT_UART_OK ) {
     
@@ -236,6 +553,49 @@ isu_dte_err_t isu_get_mt( isu_dte_t *dte, uint8_t *msg, uint16_t *msg_len, uint1
     : ISU_DTE_ERR_AT;
 }
 
+isu_dte_err_t isu_get_mt_stream( 
+  isu_dte_t *dte, uint16_t max_len, 
+  isu_mt_sink_t sink, void *user_data, uint16_t *msg_len
+) {
+
+  SEND_CONST_CMD_OR_RET( dte, "+SBDRB" );
+
+  uint16_t csum;
+  mt_stream_t stream = {
+    .sink = sink,
+    .user_data = user_data,
+  };
+
+  isbd_util_csum_init( &stream.csum );
+
+  dte->err = _unpack_bin_resp(
+    dte, &stream, max_len, msg_len, &csum, SHORT_TIMEOUT_RESPONSE );
+
+  if ( dte->err == AT_UART_OK || dte->err == AT_UART_OVERFLOW ) {
+    
+    // skipped messages are consumed completely too
+    at_uart_err_t at_err = at_uart_skip_resp( 
+      &dte->at_uart, AT_1_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
+    
+    if ( at_err != AT_UART_OK ) {
+      dte->err = at_err;
+    }
+  }
+
+  if ( dte->err != AT_UART_OK ) {
+    return ISU_DTE_ERR_AT;
+  }
+
+  uint16_t host_csum = isbd_util_csum_final( &stream.csum );
+
+  if ( csum != host_csum ) {
+    LOG_ERR( "MT checksum mismatch %04x != %04x", csum, host_csum );
+    return ISU_DTE_ERR_CSUM;
+  }
+
+  return ISU_DTE_OK;
+}
+
 /*
 int8_t isbd_set_mo_txt_l( char *__txt ) {
   
@@ -263,8 +623,7 @@ int8_t isbd_set_mo_txt_l( char *__txt ) {
 
 isu_dte_err_t isu_mo_to_mt( isu_dte_t *dte, char *out, uint16_t out_len ) {
   
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_EXEC, "+SBDTC" );
+  SEND_CONST_CMD_OR_RET( dte, "+SBDTC" );
   
   dte->err = at_uart_parse_resp(
     &dte->at_uart, out, out_len, AT_2_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
@@ -274,8 +633,7 @@ isu_dte_err_t isu_mo_to_mt( isu_dte_t *dte, char *out, uint16_t out_len ) {
 
 isu_dte_err_t isu_get_mt_txt( isu_dte_t *dte, char *mt_buf, size_t mt_buf_len ) {
   
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_EXEC, "+SBDRT" );
+  SEND_CONST_CMD_OR_RET( dte, "+SBDRT" );
 
   at_uart_skip_resp(
     &dte->at_uart, AT_1_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
@@ -322,8 +680,7 @@ isu_dte_err_t isu_get_mt_txt( isu_dte_t *dte, char *mt_buf, size_t mt_buf_len )
 
 isu_dte_err_t isu_get_sig_q( isu_dte_t *dte, uint8_t *signal_q ) {
 
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_EXEC, "+CSQ" );
+  SEND_CONST_CMD_OR_RET( dte, "+CSQ" );
   
   char buf[ 16 ];
   
@@ -331,8 +688,15 @@ isu_dte_err_t isu_get_sig_q( isu_dte_t *dte, uint8_t *signal_q ) {
     &dte->at_uart, buf, sizeof( buf ), AT_2_LINE_RESP, LONG_TIMEOUT_RESPONSE );
 
   if ( dte->err == AT_UART_OK ) {
-    int read = sscanf( buf, "+CSQ:%hhu", signal_q );
-    return read == 1 ? ISU_DTE_OK : ISU_DTE_ERR_UNK;
+    static const uint16_t max[] = { UINT8_MAX };
+    uint16_t val;
+    
+    if ( at_parse_uints( buf, "+CSQ:", &val, max, 1 ) == 1 ) {
+      *signal_q = val;
+      return ISU_DTE_OK;
+    }
+
+    return ISU_DTE_ERR_UNK;
   }
 
   return ISU_DTE_ERR_AT;
@@ -342,14 +706,46 @@ isu_dte_err_t isu_get_sig_q( isu_dte_t *dte, uint8_t *signal_q ) {
 isu_dte_err_t isu_set_evt_report( 
   isu_dte_t *dte, isu_evt_report_t *evt_report, uint8_t *sigq, uint8_t *svca
 ) {
+  return _set_evt_report( dte, evt_report, NULL, sigq, svca );
+}
 
-  char buf[ 16 ];
+isu_dte_err_t isu_set_evt_report_mt_alert( 
+  isu_dte_t *dte, isu_evt_report_t *evt_report, isu_mt_alert_t alert,
+  uint8_t *sigq, uint8_t *svca
+) {
+  return _set_evt_report( dte, evt_report, &alert, sigq, svca );
+}
 
-  snprintf( buf, sizeof( buf ), "%hhd,%hhd,%hhd", 
-    evt_report->mode, evt_report->signal, evt_report->service );
+static isu_dte_err_t _set_evt_report( 
+  isu_dte_t *dte, isu_evt_report_t *evt_report, const isu_mt_alert_t *alert,
+  uint8_t *sigq, uint8_t *svca
+) {
 
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_SET_STR, "+CIER", buf );
+  // "at+CIER=<mode>,<signal>,<service>[;+SBDMTA=<alert>]\r"
+  char cmd[ AT_INT_CMD_BUFF_SIZE ];
+  uint16_t len = AT_CMD_LEN( AT_STR "+CIER=" );
+
+  memcpy( cmd, AT_STR "+CIER=", len );
+
+  len += at_fmt_uint( &cmd[ len ], evt_report->mode );
+  cmd[ len++ ] = ',';
+  len += at_fmt_uint( &cmd[ len ], evt_report->signal );
+  cmd[ len++ ] = ',';
+  len += at_fmt_uint( &cmd[ len ], evt_report->service );
+
+  if ( alert ) {
+    memcpy( &cmd[ len ], ";+SBDMTA=", AT_CMD_LEN( ";+SBDMTA=" ) );
+    len += AT_CMD_LEN( ";+SBDMTA=" );
+    len += at_fmt_uint( &cmd[ len ], *alert );
+  }
+
+  cmd[ len++ ] = AT_CMD_EOL_STR[ 0 ];
+
+  isu_dte_err_t dte_err = isu_dte_write_cmd( dte, cmd, len );
+
+  if ( dte_err != ISU_DTE_OK ) {
+    return dte_err;
+  }
 
   at_uart_err_t at_err = at_uart_skip_resp( 
     &dte->at_uart, AT_1_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
@@ -361,30 +757,66 @@ isu_dte_err_t isu_set_evt_report(
       
     uint8_t events = // [1, 0] * ( [1, 0] + [1, 0] )
       evt_report->mode * ( evt_report->service + evt_report->signal );
-    
+
+    // ! Other events (ring alerts, ...) could have been queued before,
+    // ! they are kept apart and put back once the indicators are received.
+    // ! Putting them back right away would return them again on the next wait
+    isu_dte_evt_t others[ CONFIG_ISU_DTE_EVT_QUEUE_LEN ];
+    uint8_t n_others = 0;
+
+    // the initial indicators are sent right after the OK
+    k_timepoint_t deadline = sys_timepoint_calc( K_MSEC( SHORT_TIMEOUT_RESPONSE ) );
+
+    dte_err = ISU_DTE_OK;
+
     while ( events > 0 ) {
 
+      if ( sys_timepoint_expired( deadline ) ) {
+        dte->err = AT_UART_TIMEOUT;
+        dte_err = ISU_DTE_ERR_AT;
+        break;
+      }
+
       isu_dte_evt_t evt;
-      isu_dte_err_t dte_err = isu_dte_evt_wait(
-        dte, &evt, SHORT_TIMEOUT_RESPONSE );
+      dte_err = isu_dte_evt_wait_deadline( dte, &evt, deadline );
 
-      if ( dte_err == ISU_DTE_OK ) {
+      if ( dte_err != ISU_DTE_OK ) {
+        break;
+      }
         
-        if ( evt.id == ISU_DTE_EVT_SIGQ && sigq ) {
-          *sigq = evt.sigq;
-        } else if ( evt.id == ISU_DTE_EVT_SVCA && svca ) {
-          *svca = evt.svca;
-        }
-
+      if ( evt.id == ISU_DTE_EVT_SIGQ ) {
+        if ( sigq ) *sigq = evt.sigq;
+        events--;
+      } else if ( evt.id == ISU_DTE_EVT_SVCA ) {
+        if ( svca ) *svca = evt.svca;
         events--;
+      } else if ( n_others < ARRAY_SIZE( others ) ) {
+        others[ n_others++ ] = evt;
+      } else {
+        LOG_WRN( "Event %d dropped", evt.id );
+      }
 
+    }
+
+    // ! Events still queued were received after the held ones,
+    // ! they are put back behind them so arrival order is kept
+    isu_dte_evt_t evt;
+
+    while ( k_msgq_get( &dte->evt_msgq, &evt, K_NO_WAIT ) == 0 ) {
+      if ( n_others < ARRAY_SIZE( others ) ) {
+        others[ n_others++ ] = evt;
       } else {
-        return dte_err;
+        LOG_WRN( "Event %d dropped", evt.id );
       }
+    }
 
+    for ( uint8_t i = 0; i < n_others; i++ ) {
+      if ( k_msgq_put( &dte->evt_msgq, &others[ i ], K_NO_WAIT ) != 0 ) {
+        LOG_WRN( "Event queue full, event %d dropped", others[ i ].id );
+      }
     }
 
-    return ISU_DTE_OK;
+    return dte_err;
 
   } else {
 
@@ -396,8 +828,7 @@ isu_dte_err_t isu_set_evt_report(
 
 isu_dte_err_t isu_set_mt_alert( isu_dte_t *dte, isu_mt_alert_t alert ) {
 
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_SET_INT, "+SBDMTA", alert );
+  SEND_INT_CMD_OR_RET( dte, "+SBDMTA=", alert );
   
   dte->err = at_uart_skip_resp( 
     &dte->at_uart, AT_1_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
@@ -407,8 +838,7 @@ isu_dte_err_t isu_set_mt_alert( isu_dte_t *dte, isu_mt_alert_t alert ) {
 
 isu_dte_err_t isu_get_mt_alert( isu_dte_t *dte, isu_mt_alert_t *alert ) {
 
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_READ, "+SBDMTA" ); 
+  SEND_CONST_CMD_OR_RET( dte, "+SBDMTA?" );
 
 
   char buf[ 32 ];
@@ -417,10 +847,10 @@ isu_dte_err_t isu_get_mt_alert( isu_dte_t *dte, isu_mt_alert_t *alert ) {
 
   if ( dte->err == AT_UART_OK ) {
 
-    uint8_t val;
-    int read = sscanf( buf, "+SBDMTA:%hhu", &val );
+    static const uint16_t max[] = { UINT8_MAX };
+    uint16_t val;
     
-    if ( read == 1 ) {
+    if ( at_parse_uints( buf, "+SBDMTA:", &val, max, 1 ) == 1 ) {
       *alert = val;
       return ISU_DTE_OK;
     }
@@ -435,8 +865,7 @@ isu_dte_err_t isu_get_mt_alert( isu_dte_t *dte, isu_mt_alert_t *alert ) {
 
 isu_dte_err_t isu_net_reg( isu_dte_t *dte, isu_net_reg_sts_t *out_sts ) {
 
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_EXEC, "+SBDREG" );
+  SEND_CONST_CMD_OR_RET( dte, "+SBDREG" );
 
   char buf[ 32 ];
 
@@ -445,10 +874,13 @@ isu_dte_err_t isu_net_reg( isu_dte_t *dte, isu_net_reg_sts_t *out_sts ) {
 
   if ( dte->err == AT_UART_OK ) {
 
-    uint8_t status, code;
-    int read = sscanf( buf, "+SBDREG:%hhu,%hhu", &status, &code );
+    static const uint16_t max[] = { UINT8_MAX, UINT8_MAX };
+    uint16_t fields[ 2 ];
+
+    if ( at_parse_uints( buf, "+SBDREG:", fields, max, 2 ) == 2 ) {
 
-    if ( read == 2 ) {
+      uint8_t status = fields[ 0 ], 
+              code = fields[ 1 ];
 
       dte->err = code;
 
@@ -468,67 +900,96 @@ isu_dte_err_t isu_net_reg( isu_dte_t *dte, isu_net_reg_sts_t *out_sts ) {
 
 isu_dte_err_t isu_get_ring_sts( isu_dte_t *dte, isu_ring_sts_t *ring_sts ) {
 
-  SEND_TINY_CMD_OR_RET( 
-    dte, AT_CMD_TMPL_EXEC, "+CRIS" );
-
-  uint8_t   tri, // indicates the telephony ring indication status
-            sri; // indicates the SBD ring indication status
+  SEND_CONST_CMD_OR_RET( dte, "+CRIS" );
 
   char buf[ 32 ];
   dte->err = at_uart_parse_resp( 
     &dte->at_uart, buf, sizeof( buf ), AT_2_LINE_RESP, SHORT_TIMEOUT_RESPONSE );
 
   if ( dte->err == AT_UART_OK ) {
-    int read = sscanf( buf, "+CRIS:%hhu,%hhu", &tri, &sri );
+    // telephony ring indication status (ignored), SBD ring indication status
+    static const uint16_t max[] = { UINT8_MAX, UINT8_MAX };
+    uint16_t fields[ 2 ];
 
-    *ring_sts = sri;
-    return read == 2 ? ISU_DTE_OK : ISU_DTE_ERR_UNK;
+    if ( at_parse_uints( buf, "+CRIS:", fields, max, 2 ) == 2 ) {
+      *ring_sts = fields[ 1 ];
+      return ISU_DTE_OK;
+    }
+    
+    return ISU_DTE_ERR_UNK;
 
   } else {
     return ISU_DTE_ERR_AT;
   }
 }
 
+static void _mt_stream_cb( 
+  at_uart_t *at_uart, const uint8_t *data, uint16_t len, void *user_data 
+) {
+
+  mt_stream_t *stream = user_data;
+
+  isbd_util_csum_update( &stream->csum, data, len );
+
+  if ( stream->sink ) {
+    stream->sink( data, stream->offset, len, stream->user_data );
+  }
+
+  stream->offset += len;
+}
+
+/**
+ * @brief Unpacks a binary response ( length + message + checksum ), 
+ * the message is handed to the stream sink as it is received
+ * 
+ * @param max_len Messages longer than this are read but not handed to the sink
+ * @return at_uart_err_t AT_UART_OVERFLOW if the message was skipped
+ */
 static at_uart_err_t _unpack_bin_resp(
-  isu_dte_t *dte, 
-  uint8_t *msg_buf, uint16_t *msg_buf_len, 
-  uint16_t *csum, uint16_t timeout_ms
+  isu_dte_t *dte, mt_stream_t *stream, uint16_t max_len,
+  uint16_t *msg_len, uint16_t *csum, uint16_t timeout_ms
 ) {
 
-  uint16_t msg_len;
   at_uart_err_t ret = AT_UART_OK;
+
+  // the whole binary response shares the same deadline
+  k_timepoint_t deadline = sys_timepoint_calc( K_MSEC( timeout_ms ) );
   
-  // flag used to detect if the given buffer is smaller than necessary
-  bool overflowed = false;
+  ret = at_uart_read_deadline(
+    &dte->at_uart, (uint8_t*) msg_len, 2, deadline ); // message length
 
-  ret = at_uart_read(
-    &dte->at_uart, (uint8_t*) &msg_len, 2, timeout_ms ); // message length
+  if ( ret != AT_UART_OK ) {
+    return ret;
+  }
+  
+  *msg_len = ntohs( *msg_len );
+
+  if ( *msg_len > MT_MAX_LEN ) {
+    // ! Not a valid length ( remanent chars, electrical noise ... ), 
+    // ! so the end of the message is unknown. Bytes received until the
+    // ! deadline are discarded, otherwise they would be parsed as text
+    // ! ( and maybe as URCs ) before the next command
+    LOG_ERR( "Invalid MT length %hu", *msg_len );
+    at_uart_read_stream_deadline( &dte->at_uart, UINT16_MAX, NULL, NULL, deadline );
+    return AT_UART_ERR;
+  }
 
-  if ( ret == AT_UART_OK ) {
-    
-    msg_len = ntohs( msg_len );
+  bool overflowed = *msg_len > max_len;
 
-    if ( msg_len > *msg_buf_len ) {
-      // msg_buf = NULL; // skip data
-      overflowed = true;
-      LOG_ERR( "Overflow %hu > %hu\n", msg_len, *msg_buf_len );
-    } else {
-      *msg_buf_len = msg_len;
-    }
-    
-    // ! This will probably block if received length is not valid
-    // ! due to remanent chars or electrical noise ... 
-    ret = at_uart_read(
-      &dte->at_uart, msg_buf, *msg_buf_len, timeout_ms );
+  if ( overflowed ) {
+    LOG_ERR( "Overflow %hu > %hu, skipping message", *msg_len, max_len );
+    stream->sink = NULL;
+  }
 
-  }  
+  ret = at_uart_read_stream_deadline(
+    &dte->at_uart, *msg_len, _mt_stream_cb, stream, deadline );
 
   if ( ret == AT_UART_OK ) {
-    ret = at_uart_read(
-      &dte->at_uart, (uint8_t*)csum, 2, timeout_ms );
+    ret = at_uart_read_deadline(
+      &dte->at_uart, (uint8_t*)csum, 2, deadline );
 
     *csum = ntohs( *csum );
   }
 
-  return overflowed ? AT_UART_OVERFLOW : ret;
+  return overflowed && ret == AT_UART_OK ? AT_UART_OVERFLOW : ret;
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
   #define ZUART_H_
   
   #include <stdint.h>
+  #include <stdbool.h>
   #include <zephyr/sys/ring_buffer.h>
 
   #define ZUART_CONF_DEFAULT( _dev ) \
@@ -58,6 +59,39 @@
       .write_proto = zuart_write_irq_proto, \
     }
 
+  /**
+   * @brief Asynchronous (DMA) mode configuration, requires CONFIG_Z_UART_ASYNC.
+   * Ring buffers are used in the same way as in interrupt mode
+   */
+  #define ZUART_CONF_ASYNC( _dev, _rx_buf, _rx_buf_size, _tx_buf, _tx_buf_size ) \
+    { \
+      .dev = _dev, \
+      .rx_buf = _rx_buf, \
+      .rx_buf_size = _rx_buf_size, \
+      .tx_buf = _tx_buf, \
+      .tx_buf_size = _tx_buf_size, \
+      .mode = ZUART_MODE_ASYNC, \
+    }
+
+  /**
+   * @brief Timer driven polling mode configuration. The UART is sampled
+   * periodically from a timer and received bytes are stored in the
+   * reception ring buffer, so readers block as in interrupt mode.
+   * Transmission uses polling technique
+   * 
+   * @note The kernel tick must be shorter than the time needed to fill the 
+   * hardware FIFO, see CONFIG_Z_UART_TIMER_FIFO_DEPTH
+   */
+  #define ZUART_CONF_TIMER( _dev, _rx_buf, _rx_buf_size ) \
+    { \
+      .dev = _dev, \
+      .rx_buf = _rx_buf, \
+      .rx_buf_size = _rx_buf_size, \
+      .tx_buf = NULL, \
+      .tx_buf_size = 0, \
+      .mode = ZUART_MODE_TIMER, \
+    }
+
   typedef enum zuart_err {
     ZUART_OK              = 0,
     ZUART_ERR             = -1,
@@ -70,19 +104,86 @@
     ZUART_MODE_IRQ,
     ZUART_MODE_POLL,
     ZUART_MODE_MIXED,
+    ZUART_MODE_ASYNC,
+    ZUART_MODE_TIMER,
   } zuart_mode_t;
 
+  /**
+   * @brief Policies used to decide when readers blocked in zuart_read()
+   * should be woken up. Policies can be combined, readers will be woken up
+   * as soon as any of them is satisfied or when the reception buffer is full
+   */
+  typedef enum zuart_rx_wake_policy {
+    
+    /**
+     * @brief Wake up on every received chunk (default)
+     */
+    ZUART_RX_WAKE_ANY       = 0,
+
+    /**
+     * @brief Wake up when at least N bytes are buffered
+     */
+    ZUART_RX_WAKE_BYTES     = BIT( 0 ),
+
+    /**
+     * @brief Wake up after an idle gap of X character times
+     */
+    ZUART_RX_WAKE_IDLE      = BIT( 1 ),
+
+    /**
+     * @brief Wake up when a delimiter byte is received
+     */
+    ZUART_RX_WAKE_DELIM     = BIT( 2 ),
+
+  } zuart_rx_wake_policy_t;
+
+  typedef struct zuart_rx_wake {
+    uint8_t policy; /** Combination of zuart_rx_wake_policy_t values */
+    uint8_t delim; /** Delimiter byte used by ZUART_RX_WAKE_DELIM */
+    uint16_t bytes; /** Number of bytes used by ZUART_RX_WAKE_BYTES */
+    uint16_t idle_chars; /** Idle gap (in character times) used by ZUART_RX_WAKE_IDLE */
+  } zuart_rx_wake_t;
+
+  /**
+   * @brief zuart instance statistics, only updated when CONFIG_Z_UART_STATS is enabled
+   */
+  typedef struct zuart_stats {
+    uint32_t rx_bytes; /** Bytes received */
+    uint32_t tx_bytes; /** Bytes transmitted */
+    uint32_t isr_calls; /** UART interrupt (or asynchronous callback) invocations */
+    uint32_t rx_dropped; /** Received bytes dropped due to overruns */
+    uint32_t rx_timeouts; /** Reads which timed out */
+    uint32_t tx_timeouts; /** Writes which timed out */
+    uint32_t rx_peak; /** Peak reception ring buffer occupancy */
+    uint32_t tx_peak; /** Peak transmission ring buffer occupancy */
+    uint64_t rx_wait_ticks; /** Time spent blocked waiting for received bytes */
+    uint64_t tx_wait_ticks; /** Time spent blocked waiting for transmission space */
+  } zuart_stats_t;
+
   typedef struct zuart zuart_t;
   typedef struct zuart_config zuart_config_t;
 
+  /**
+   * @brief Prototypes receive an absolute deadline, so waits inside a single 
+   * call never extend beyond it no matter how many times they block.
+   * A deadline computed from K_NO_WAIT means do not block at all
+   */
   typedef uint16_t (*zuart_read_proto_t)(
-    zuart_t *zuart, uint8_t *src_buffer, uint16_t n_bytes, uint32_t timeout_ms 
+    zuart_t *zuart, uint8_t *src_buffer, uint16_t n_bytes, k_timepoint_t deadline 
   );
 
   typedef uint16_t (*zuart_write_proto_t)( 
-    zuart_t *zuart, const uint8_t *src_buffer, uint16_t n_bytes, uint32_t timeout_ms 
+    zuart_t *zuart, const uint8_t *src_buffer, uint16_t n_bytes, k_timepoint_t deadline 
   );
 
+  /**
+   * @brief Buffer segment used by vectored writes, see zuart_writev()
+   */
+  typedef struct zuart_iovec {
+    const uint8_t *buf;
+    uint16_t len;
+  } zuart_iovec_t;
+
   struct zuart_config {
     
     zuart_mode_t mode;
@@ -90,8 +191,21 @@
     uint8_t *tx_buf;
     uint32_t tx_buf_size;
 
+    /**
+     * @brief Writers waiting for space in the transmission ring buffer are
+     * only signalled when the number of pending bytes drops to this value or below.
+     * Use 0 to default to half of the transmission buffer size
+     */
+    uint32_t tx_low_watermark;
+
     uint8_t *rx_buf;
     uint32_t rx_buf_size;
+
+    /**
+     * @brief Reader wake up policy, only used by ring buffer based reception modes.
+     * Ring buffer behaviour is not affected, only when readers are signalled
+     */
+    zuart_rx_wake_t rx_wake;
     
     struct device *dev;
 
@@ -113,7 +227,23 @@
     struct ring_buf rx_rbuf;
     struct ring_buf tx_rbuf;
 
+    struct k_timer rx_poll_timer; // used by ZUART_MODE_TIMER
+    struct k_timer rx_idle_timer; // used by ZUART_RX_WAKE_IDLE policy
+    k_timeout_t rx_idle_timeout; // idle gap computed from the UART configuration
+
     zuart_config_t config;
+
+  #ifdef CONFIG_Z_UART_STATS
+    zuart_stats_t stats; // for internal use only, see zuart_stats_get()
+  #endif
+
+  #ifdef CONFIG_Z_UART_ASYNC
+    struct {
+      atomic_t tx_busy; // a DMA transfer is currently in progress
+      uint8_t rx_buf_idx; // next RX buffer to be handed to the driver
+      uint8_t rx_buf[ 2 ][ CONFIG_Z_UART_ASYNC_RX_BUF_SIZE ];
+    } async; // for internal use only
+  #endif
   };
 
   /**
@@ -134,6 +264,20 @@
    * @return int 
    */
   zuart_err_t zuart_setup( zuart_t *zuart, const zuart_config_t *zuart_config );
+
+  /**
+   * @brief Reconfigures the baudrate of the underlying UART, the rest of 
+   * the UART configuration is kept. Character based timings 
+   * (idle wake up gap, timer mode sampling period) are recomputed
+   * 
+   * @note Pending transmissions should be completed before calling this function
+   * 
+   * @param zuart 
+   * @param baudrate New baudrate
+   * @return zuart_err_t ZUART_ERR_SETUP in timer mode if the kernel tick is too
+   * long for the new baudrate, the baudrate is applied anyway
+   */
+  zuart_err_t zuart_set_baudrate( zuart_t *zuart, uint32_t baudrate );
   
   /**
    * @brief Request a specific number of bytes from que reception buffer.
@@ -148,6 +292,37 @@
    */
   uint16_t zuart_read( zuart_t *zuart, uint8_t *out_buffer, uint16_t n_bytes, uint32_t ms_timeout );
 
+  /**
+   * @brief Same as zuart_read() but bounded by an absolute deadline
+   * 
+   * @param deadline Point in time after which this call will not wait anymore,
+   * see sys_timepoint_calc()
+   */
+  uint16_t zuart_read_deadline( 
+    zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, k_timepoint_t deadline );
+
+  /**
+   * @brief Reads bytes until any of the given delimiters is found (included)
+   * or until the output buffer is full. Ring buffer based modes scan the 
+   * reception buffer in bulk, other modes fall back to byte by byte reads.
+   * Timeout semantics are the same as zuart_read()
+   * 
+   * @param zuart zuart instance
+   * @param out_buf Output buffer, use NULL to discard read bytes
+   * @param n_bytes Maximum number of bytes to read
+   * @param delims Null terminated set of delimiter chars, for example "\r\n"
+   * @param timeout_ms The number of milliseconds this function should wait
+   * @return uint16_t Number of bytes read, including the delimiter (if found)
+   */
+  uint16_t zuart_read_until( 
+    zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, const char *delims, uint32_t timeout_ms );
+
+  /**
+   * @brief Same as zuart_read_until() but bounded by an absolute deadline
+   */
+  uint16_t zuart_read_until_deadline( 
+    zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, const char *delims, k_timepoint_t deadline );
+
   /**
    * @brief Write a given number of bytes into the transmission buffer.
    * This function is not thread safe
@@ -160,6 +335,33 @@
    */
   uint16_t zuart_write( zuart_t *zuart, const uint8_t *src_buffer, uint16_t n_bytes, uint32_t ms_timeout );
 
+  /**
+   * @brief Same as zuart_write() but bounded by an absolute deadline
+   */
+  uint16_t zuart_write_deadline( 
+    zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline );
+
+  /**
+   * @brief Writes the given segments in order, as if they were a single 
+   * contiguous buffer. When the transmission ring buffer is used 
+   * all segments are queued in one operation and transmitted back to back.
+   * This function is not thread safe
+   * 
+   * @param iov Segments to write
+   * @param iovcnt Number of segments
+   * @param timeout_ms Bounds the whole write, not each segment
+   * @return uint32_t Total number of bytes written, if it is less than the sum
+   * of all segment lengths see zuart_get_err()
+   */
+  uint32_t zuart_writev( 
+    zuart_t *zuart, const zuart_iovec_t *iov, uint8_t iovcnt, uint32_t timeout_ms );
+
+  /**
+   * @brief Same as zuart_writev() but bounded by an absolute deadline
+   */
+  uint32_t zuart_writev_deadline( 
+    zuart_t *zuart, const zuart_iovec_t *iov, uint8_t iovcnt, k_timepoint_t deadline );
+
   /**
    * @brief Purges UART reception buffer
    * 
@@ -174,10 +376,10 @@
    * @param zuart 
    * @param out_buf 
    * @param n_bytes 
-   * @param timeout_ms 
+   * @param deadline 
    * @return int32_t 
    */
-  uint16_t zuart_read_irq_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, uint32_t timeout_ms );
+  uint16_t zuart_read_irq_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, k_timepoint_t deadline );
   
   /**
    * @brief Reads from serial port using polling technique
@@ -191,10 +393,10 @@
    * @param zuart 
    * @param out_buf 
    * @param n_bytes 
-   * @param timeout_ms 
+   * @param deadline 
    * @return int32_t 
    */
-  uint16_t zuart_read_poll_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, uint32_t timeout_ms );
+  uint16_t zuart_read_poll_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, k_timepoint_t deadline );
 
   /**
    * @brief Write to serial port using interrupts technique
@@ -202,11 +404,27 @@
    * @param zuart 
    * @param src_buf 
    * @param n_bytes 
-   * @param timeout_ms 
+   * @param deadline 
    * @return int32_t 
    */
-  uint16_t zuart_write_irq_proto( zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, uint32_t timeout_ms );
-  uint16_t zuart_write_poll_proto( zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, uint32_t timeout_ms );
+  uint16_t zuart_write_irq_proto( zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline );
+
+  /**
+   * @brief Write to serial port using the asynchronous UART API.
+   * The transmission ring buffer is handed to the driver in contiguous chunks
+   * 
+   * @note Reception in asynchronous mode is done through zuart_read_irq_proto()
+   * as received chunks are stored in the same reception ring buffer
+   * 
+   * @param zuart 
+   * @param src_buf 
+   * @param n_bytes 
+   * @param deadline 
+   * @return uint16_t 
+   */
+  uint16_t zuart_write_async_proto( zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline );
+
+  uint16_t zuart_write_poll_proto( zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline );
 
   void zuart_force_read_timeout( zuart_t *zuart );
   void zuart_force_write_timeout( zuart_t *zuart );
@@ -221,4 +439,98 @@
    */
   uint16_t zuart_available( zuart_t *zuart );
   
+  /**
+   * @brief Checks if the reception buffer can be accessed in place
+   * using zuart_rx_claim(), zuart_rx_peek() and zuart_rx_finish()
+   * 
+   * @note Only ring buffer based reception modes (interrupt, asynchronous
+   * and timer) support zero-copy access
+   * 
+   * @param zuart 
+   * @return true Zero-copy access is supported
+   */
+  bool zuart_rx_claim_supported( zuart_t *zuart );
+
+#ifdef CONFIG_POLL
+  /**
+   * @brief Initializes a poll event which is signalled when bytes are received,
+   * so reception can be waited along with other kernel objects, see k_poll()
+   * 
+   * @note The event follows the configured wake up policy. Pending signals
+   * are cleared, so bytes which are already buffered are not signalled again, 
+   * check zuart_available() afterwards. Must be called from the reading thread
+   * 
+   * @param zuart 
+   * @param event Event to initialize
+   * @return true The event was initialized, false if reception is not 
+   * signalled in the current mode, see zuart_rx_claim_supported()
+   */
+  bool zuart_rx_poll_event_init( zuart_t *zuart, struct k_poll_event *event );
+#endif
+
+  /**
+   * @brief Claims a contiguous region of received bytes without copying them.
+   * If there are no unclaimed bytes this call waits for them.
+   * 
+   * @note Claimed regions are contiguous in memory, so when received data wraps
+   * around the end of the reception buffer this function has to be called again
+   * in order to claim the remaining bytes. Claimed bytes are not released until
+   * zuart_rx_finish() is called
+   * 
+   * @param zuart 
+   * @param data Output pointer to the first claimed byte
+   * @param size Maximum number of bytes to claim
+   * @param timeout_ms The number of milliseconds this function should wait
+   * @return uint32_t Number of claimed bytes
+   */
+  uint32_t zuart_rx_claim( 
+    zuart_t *zuart, uint8_t **data, uint32_t size, uint32_t timeout_ms );
+
+  /**
+   * @brief Same as zuart_rx_claim() but bounded by an absolute deadline
+   */
+  uint32_t zuart_rx_claim_deadline( 
+    zuart_t *zuart, uint8_t **data, uint32_t size, k_timepoint_t deadline );
+
+  /**
+   * @brief Copies received bytes without consuming them, 
+   * wrap-around is handled internally.
+   * 
+   * @note Must not be used while there are claimed regions, 
+   * as outstanding claims are released
+   * 
+   * @param zuart 
+   * @param out_buf Output buffer
+   * @param size Maximum number of bytes to copy
+   * @return uint32_t Number of copied bytes
+   */
+  uint32_t zuart_rx_peek( zuart_t *zuart, uint8_t *out_buf, uint32_t size );
+
+  /**
+   * @brief Consumes the given number of previously claimed bytes,
+   * remaining claimed bytes are released and will be claimed again
+   * 
+   * @param zuart 
+   * @param size Number of bytes to consume, can not exceed the claimed bytes
+   * @return zuart_err_t 
+   */
+  zuart_err_t zuart_rx_finish( zuart_t *zuart, uint32_t size );
+
+  /**
+   * @brief Takes a snapshot of the instance statistics
+   * 
+   * @note If CONFIG_Z_UART_STATS is not enabled all counters will be zero
+   * 
+   * @param zuart 
+   * @param stats Output statistics
+   */
+  void zuart_stats_get( zuart_t *zuart, zuart_stats_t *stats );
+
+  /**
+   * @brief Resets all the instance statistics, including ring buffer peaks
+   * 
+   * @param zuart 
+   */
+  void zuart_stats_reset( zuart_t *zuart );
+
 #endif
\ No newline at end of file
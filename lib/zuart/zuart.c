@@ -1,3 +1,4 @@
+#include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
 #include <zephyr/drivers/uart.h>
@@ -15,6 +16,29 @@
 #define GET_FLAG( var, flag ) \
   ( (var) & BIT( flag ) )
 
+// sys_timepoint_calc( K_NO_WAIT ) always results in the same timepoint,
+// used to distinguish non blocking calls from already expired deadlines
+#define DEADLINE_IS_NO_WAIT( deadline ) \
+  ( sys_timepoint_cmp( (deadline), sys_timepoint_calc( K_NO_WAIT ) ) == 0 )
+
+#ifdef CONFIG_Z_UART_STATS
+
+  #define STATS_ADD( zuart, field, n ) \
+    ( (zuart)->stats.field += (n) )
+
+  #define STATS_PEAK( zuart, field, val ) \
+    do { \
+      uint32_t M_val = (val); \
+      if ( M_val > (zuart)->stats.field ) (zuart)->stats.field = M_val; \
+    } while ( 0 )
+
+#else
+
+  #define STATS_ADD( zuart, field, n )
+  #define STATS_PEAK( zuart, field, val )
+
+#endif
+
 // --------- Start of private methods -----------
 /**
  * @brief UART ISR handler
@@ -23,23 +47,100 @@
  * @param user_data Pointer to the zuart struct
  */
 static void _uart_isr( const struct device *dev, void *user_data );
+
+/**
+ * @brief Writes the given buffer into the transmission ring buffer
+ * 
+ * @param tx_start Function used to start the transmission of the ring buffer
+ */
+static uint32_t _writev_tx_rbuf( 
+  zuart_t *zuart, const zuart_iovec_t *iov, uint8_t iovcnt, k_timepoint_t deadline,
+  void (*tx_start)( zuart_t *zuart ) 
+);
+
+static void _uart_irq_tx_start( zuart_t *zuart );
+
+/**
+ * @brief Waits for received bytes until the given deadline, 
+ * time spent blocked is accounted
+ */
+static int _rx_sem_take( zuart_t *zuart, k_timepoint_t deadline );
+
+/**
+ * @brief Waits for space in the transmission buffer until the given deadline, 
+ * time spent blocked is accounted
+ */
+static int _tx_sem_take( zuart_t *zuart, k_timepoint_t deadline );
+
+/**
+ * @brief Updates the last error after a ring buffer based read
+ * 
+ * @param sem_ret Last semaphore result
+ */
+static void _rx_update_err( zuart_t *zuart, k_timepoint_t deadline, int sem_ret );
+
+/**
+ * @brief Computes the idle gap used by ZUART_RX_WAKE_IDLE policy
+ * from the current UART configuration
+ */
+static void _rx_wake_setup( zuart_t *zuart );
+
+/**
+ * @brief Idle timer expiry handler, wakes up blocked readers
+ */
+static void _rx_idle_expired( struct k_timer *timer );
+
+/**
+ * @brief Computes the idle gap used by ZUART_RX_WAKE_IDLE policy
+ */
+static k_timeout_t _rx_idle_timeout( zuart_t *zuart );
+
+/**
+ * @brief Computes the sampling period used by ZUART_MODE_TIMER,
+ * rounded up to whole kernel ticks
+ * 
+ * @param period Output sampling period
+ * @return zuart_err_t ZUART_ERR_SETUP if the period is not shorter than the
+ * time needed to fill the hardware FIFO, received bytes would be dropped
+ */
+static zuart_err_t _rx_poll_period( zuart_t *zuart, k_timeout_t *period );
+
+/**
+ * @brief Starts the timer used to sample the UART in ZUART_MODE_TIMER
+ */
+static zuart_err_t _rx_poll_timer_setup( zuart_t *zuart );
+
+/**
+ * @brief Polling timer expiry handler, drains the UART into the reception buffer
+ */
+static void _rx_poll_timer_expired( struct k_timer *timer );
+
+#ifdef CONFIG_Z_UART_ASYNC
+/**
+ * @brief UART asynchronous API callback
+ * 
+ * @param dev UART driver instance
+ * @param evt UART event
+ * @param user_data Pointer to the zuart struct
+ */
+static void _uart_async_cb( const struct device *dev, struct uart_event *evt, void *user_data );
+
+static void _uart_async_tx_start( zuart_t *zuart );
+static zuart_err_t _uart_async_setup( zuart_t *zuart );
+#endif
 // ---------- End of private methods -----------
 
 // TODO: think about using events
 
-uint16_t zuart_read_irq_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, uint32_t timeout_ms ) {
+uint16_t zuart_read_irq_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, k_timepoint_t deadline ) {
   
   int sem_ret = 0;
   uint16_t total_bytes_read = 0;
 
-  // this conversion takes a little due to arithmetic division
-  // so we temporary store the value instead of recomputing for each loop
-  k_timeout_t k_timeout = K_MSEC( timeout_ms );
-
   while ( total_bytes_read < n_bytes ) {
     
     if ( ring_buf_is_empty( &zuart->rx_rbuf ) ) {
-      sem_ret = k_sem_take( &zuart->rx_sem, k_timeout );
+      sem_ret = _rx_sem_take( zuart, deadline );
       if ( sem_ret < 0 ) break;
     }
 
@@ -66,22 +167,17 @@ uint16_t zuart_read_irq_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_byte
   //   total_bytes_read += bytes_read;
   // }
 
-  if ( GET_FLAG( zuart->flags, FLAG_OVERRUN ) ) {
-    zuart->err = ZUART_ERR_OVERRUN;
-    CLEAR_FLAG( zuart->flags, FLAG_OVERRUN );
-  } else if ( timeout_ms > 0 && sem_ret ) {
-    zuart->err = ZUART_ERR_TIMEOUT;
-  }
+  _rx_update_err( zuart, deadline, sem_ret );
 
   return total_bytes_read;
 }
 
-uint16_t zuart_read_poll_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, uint32_t timeout_ms ) {
+uint16_t zuart_read_poll_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, k_timepoint_t deadline ) {
 
   uint8_t byte;
   uint16_t total_bytes_read = 0;
 
-  if ( timeout_ms == 0 ) {
+  if ( DEADLINE_IS_NO_WAIT( deadline ) ) {
 
     while ( total_bytes_read < n_bytes 
       && uart_poll_in( zuart->dev, &byte ) == 0 ) {
@@ -94,17 +190,8 @@ uint16_t zuart_read_poll_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_byt
     }
 
   } else {
-    
-    uint64_t ts_old = k_uptime_get();
 
     while ( total_bytes_read < n_bytes ) {
-
-      uint64_t ts_now = k_uptime_get();
-
-      if ( ts_now - ts_old >= timeout_ms ) {
-        zuart->err = ZUART_ERR_TIMEOUT;
-        break;
-      }
       
       int ret = uart_poll_in( zuart->dev, &byte );      
 
@@ -117,6 +204,13 @@ uint16_t zuart_read_poll_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_byt
 
       } else if ( ret == -1 ) {
 
+        // the uptime is only checked while there are no bytes available
+        if ( sys_timepoint_expired( deadline ) ) {
+          zuart->err = ZUART_ERR_TIMEOUT;
+          STATS_ADD( zuart, rx_timeouts, 1 );
+          break;
+        }
+
         // ! When using polling mode, uart_poll_in() is
         // ! non blocking and returns -1 when there are no bytes
         // ! available, so in such situation (current code block)
@@ -128,7 +222,7 @@ uint16_t zuart_read_poll_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_byt
         // ! 
         // ! With this, I want to say that it is very important to configure priorities
         // ! correctly in order to avoid such situations, whenever possible use interrupt
-        // ! mode instead
+        // ! mode instead (or ZUART_MODE_TIMER when the driver lacks interrupt support)
         k_yield();
 
         // ! Another option could consist by adding a little sleep in order to avoid the kernel
@@ -145,61 +239,211 @@ uint16_t zuart_read_poll_proto( zuart_t *zuart, uint8_t *out_buf, uint16_t n_byt
 
   }
 
+  STATS_ADD( zuart, rx_bytes, total_bytes_read );
+
   return total_bytes_read; 
 }
 
 uint16_t zuart_read(
   zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, uint32_t timeout_ms 
+) {
+  return zuart_read_deadline( 
+    zuart, out_buf, n_bytes, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
+uint16_t zuart_read_deadline(
+  zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, k_timepoint_t deadline 
 ) {
   if ( zuart->config.read_proto ) {
-    return zuart->config.read_proto( zuart, out_buf, n_bytes, timeout_ms );
+    return zuart->config.read_proto( zuart, out_buf, n_bytes, deadline );
   }
   
   zuart->err = ZUART_ERR;
   return 0;
 }
 
+/**
+ * @brief Scans the given span looking for the first occurrence
+ * of any of the given delimiters
+ * 
+ * @param len Span length, updated with the number of bytes 
+ * until the delimiter (included) when found
+ * @return true A delimiter was found
+ */
+static inline bool _scan_delims( const uint8_t *data, uint32_t *len, const char *delims ) {
+
+  bool found = false;
+
+  for ( ; *delims; delims++ ) {
+    
+    const uint8_t *delim = memchr( data, *delims, *len );
+    
+    if ( delim ) {
+      // shrink the span, so next delimiters are only
+      // searched before the current one
+      *len = delim - data + 1;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+uint16_t zuart_read_until( 
+  zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, const char *delims, uint32_t timeout_ms 
+) {
+  return zuart_read_until_deadline( 
+    zuart, out_buf, n_bytes, delims, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
+uint16_t zuart_read_until_deadline( 
+  zuart_t *zuart, uint8_t *out_buf, uint16_t n_bytes, const char *delims, k_timepoint_t deadline 
+) {
+
+  uint16_t total_bytes_read = 0;
+
+  if ( zuart->config.read_proto != zuart_read_irq_proto ) {
+
+    // no ring buffer available, read byte by byte
+    while ( total_bytes_read < n_bytes ) {
+      
+      uint8_t byte;
+
+      if ( zuart_read_deadline( zuart, &byte, 1, deadline ) != 1 ) {
+        break;
+      }
+
+      if ( out_buf ) {
+        out_buf[ total_bytes_read ] = byte;
+      }
+
+      total_bytes_read++;
+
+      if ( byte && strchr( delims, byte ) ) {
+        break;
+      }
+    }
+
+    return total_bytes_read;
+  }
+
+  int sem_ret = 0;
+
+  while ( total_bytes_read < n_bytes ) {
+
+    uint8_t *data;
+    uint32_t len = ring_buf_get_claim(
+      &zuart->rx_rbuf, &data, n_bytes - total_bytes_read );
+
+    if ( len == 0 ) {
+      sem_ret = _rx_sem_take( zuart, deadline );
+      if ( sem_ret < 0 ) break;
+      continue;
+    }
+
+    bool found = _scan_delims( data, &len, delims );
+
+    if ( out_buf ) {
+      memcpy( out_buf + total_bytes_read, data, len );
+    }
+
+    ring_buf_get_finish( &zuart->rx_rbuf, len );
+    total_bytes_read += len;
+
+    if ( found ) break;
+  }
+
+  _rx_update_err( zuart, deadline, sem_ret );
+
+  return total_bytes_read;
+}
+
 uint16_t zuart_write_irq_proto(
-  zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, uint32_t timeout_ms 
+  zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline 
 ) {
+  zuart_iovec_t iov = { .buf = src_buf, .len = n_bytes };
   
-  k_sem_reset( &zuart->tx_sem );
+  return _writev_tx_rbuf( 
+    zuart, &iov, 1, deadline, _uart_irq_tx_start );
+}
 
-  // ! This function is public so the user should take care ONLY 
-  // ! if concurrent writes are a possibility
-  uint16_t total_bytes_written = 0;
+#ifdef CONFIG_Z_UART_ASYNC
+uint16_t zuart_write_async_proto(
+  zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline 
+) {
+  zuart_iovec_t iov = { .buf = src_buf, .len = n_bytes };
   
-  if ( timeout_ms == 0 ) {
-    total_bytes_written = ring_buf_put( &zuart->tx_rbuf, src_buf, n_bytes );
-    uart_irq_tx_enable( zuart->dev );
-  } else {
-    
-    k_timeout_t k_timeout = K_MSEC( timeout_ms );
+  return _writev_tx_rbuf( 
+    zuart, &iov, 1, deadline, _uart_async_tx_start );
+}
+#endif
 
-    while ( total_bytes_written < n_bytes ) {
-      
-      if ( ring_buf_space_get( &zuart->tx_rbuf ) == 0 ) {
-        if ( k_sem_take( &zuart->tx_sem, k_timeout ) != 0 ) {
-          zuart->err = ZUART_ERR_TIMEOUT;
-          break;
-        }
-      }
+static uint16_t _write_tx_seg( 
+  zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline,
+  void (*tx_start)( zuart_t *zuart ) 
+) {
 
-      total_bytes_written += ring_buf_put(
-        &zuart->tx_rbuf, src_buf + total_bytes_written, n_bytes - total_bytes_written );
+  uint16_t bytes_written = 0;
+
+  while ( bytes_written < n_bytes ) {
+    
+    if ( ring_buf_space_get( &zuart->tx_rbuf ) == 0 ) {
       
-      // enable irq to transmit ring buffer
-      uart_irq_tx_enable( zuart->dev );
+      // start transmission of the ring buffer before waiting for space
+      tx_start( zuart );
 
+      if ( DEADLINE_IS_NO_WAIT( deadline ) ) {
+        break;
+      }
+
+      if ( _tx_sem_take( zuart, deadline ) != 0 ) {
+        zuart->err = ZUART_ERR_TIMEOUT;
+        STATS_ADD( zuart, tx_timeouts, 1 );
+        break;
+      }
     }
 
+    bytes_written += ring_buf_put(
+      &zuart->tx_rbuf, src_buf + bytes_written, n_bytes - bytes_written );
+    
+    STATS_PEAK( zuart, tx_peak, ring_buf_size_get( &zuart->tx_rbuf ) );
+  }
+
+  return bytes_written;
+}
+
+static uint32_t _writev_tx_rbuf( 
+  zuart_t *zuart, const zuart_iovec_t *iov, uint8_t iovcnt, k_timepoint_t deadline,
+  void (*tx_start)( zuart_t *zuart ) 
+) {
+  
+  k_sem_reset( &zuart->tx_sem );
+
+  // ! This function is public so the user should take care ONLY 
+  // ! if concurrent writes are a possibility
+  uint32_t total_bytes_written = 0;
+
+  for ( uint8_t i = 0; i < iovcnt; i++ ) {
+    
+    uint16_t bytes_written = _write_tx_seg( 
+      zuart, iov[ i ].buf, iov[ i ].len, deadline, tx_start );
+    
+    total_bytes_written += bytes_written;
+
+    if ( bytes_written < iov[ i ].len ) {
+      break;
+    }
   }
 
+  // segments are queued back to back, so they are transmitted
+  // without gaps, as if they were a single contiguous buffer
+  tx_start( zuart );
+
   return total_bytes_written;
 }
 
 uint16_t zuart_write_poll_proto(
-  zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, uint32_t timeout_ms 
+  zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline 
 ) {
 
   uint16_t bytes_written = 0;
@@ -210,6 +454,8 @@ uint16_t zuart_write_poll_proto(
     bytes_written++;
   }
 
+  STATS_ADD( zuart, tx_bytes, bytes_written );
+
   return bytes_written;
 }
 
@@ -217,9 +463,16 @@ uint16_t zuart_write_poll_proto(
 uint16_t zuart_write( 
   zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, uint32_t timeout_ms 
 ) {
+  return zuart_write_deadline( 
+    zuart, src_buf, n_bytes, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
+uint16_t zuart_write_deadline( 
+  zuart_t *zuart, const uint8_t *src_buf, uint16_t n_bytes, k_timepoint_t deadline 
+) {
 
   if ( zuart->config.write_proto ) {
-    return zuart->config.write_proto( zuart, src_buf, n_bytes, timeout_ms );
+    return zuart->config.write_proto( zuart, src_buf, n_bytes, deadline );
   }
 
   zuart->err = ZUART_ERR;
@@ -227,6 +480,47 @@ uint16_t zuart_write(
 
 }
 
+uint32_t zuart_writev( 
+  zuart_t *zuart, const zuart_iovec_t *iov, uint8_t iovcnt, uint32_t timeout_ms 
+) {
+  return zuart_writev_deadline( 
+    zuart, iov, iovcnt, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
+uint32_t zuart_writev_deadline( 
+  zuart_t *zuart, const zuart_iovec_t *iov, uint8_t iovcnt, k_timepoint_t deadline 
+) {
+
+  if ( zuart->config.write_proto == zuart_write_irq_proto ) {
+    return _writev_tx_rbuf( 
+      zuart, iov, iovcnt, deadline, _uart_irq_tx_start );
+  }
+
+#ifdef CONFIG_Z_UART_ASYNC
+  if ( zuart->config.write_proto == zuart_write_async_proto ) {
+    return _writev_tx_rbuf( 
+      zuart, iov, iovcnt, deadline, _uart_async_tx_start );
+  }
+#endif
+
+  // unbuffered modes write segments one after another
+  uint32_t total_bytes_written = 0;
+
+  for ( uint8_t i = 0; i < iovcnt; i++ ) {
+    
+    uint16_t bytes_written = zuart_write_deadline( 
+      zuart, iov[ i ].buf, iov[ i ].len, deadline );
+    
+    total_bytes_written += bytes_written;
+
+    if ( bytes_written < iov[ i ].len ) {
+      break;
+    }
+  }
+
+  return total_bytes_written;
+}
+
 uint16_t zuart_available( zuart_t *zuart ) {
   if ( zuart->config.read_proto == zuart_read_irq_proto ) {
     return ring_buf_size_get( &zuart->rx_rbuf );
@@ -234,6 +528,79 @@ uint16_t zuart_available( zuart_t *zuart ) {
   return 0;
 }
 
+bool zuart_rx_claim_supported( zuart_t *zuart ) {
+  return zuart->config.read_proto == zuart_read_irq_proto;
+}
+
+#ifdef CONFIG_POLL
+bool zuart_rx_poll_event_init( zuart_t *zuart, struct k_poll_event *event ) {
+
+  // only ring buffer based modes signal received bytes
+  if ( !zuart_rx_claim_supported( zuart ) ) {
+    return false;
+  }
+
+  // ! Readers only take the semaphore when the ring buffer is empty,
+  // ! so it may have been left available by bytes which were already read
+  k_sem_reset( &zuart->rx_sem );
+
+  k_poll_event_init( 
+    event, K_POLL_TYPE_SEM_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &zuart->rx_sem );
+
+  return true;
+}
+#endif
+
+uint32_t zuart_rx_claim( 
+  zuart_t *zuart, uint8_t **data, uint32_t size, uint32_t timeout_ms 
+) {
+  return zuart_rx_claim_deadline( 
+    zuart, data, size, sys_timepoint_calc( K_MSEC( timeout_ms ) ) );
+}
+
+uint32_t zuart_rx_claim_deadline( 
+  zuart_t *zuart, uint8_t **data, uint32_t size, k_timepoint_t deadline 
+) {
+
+  if ( !zuart_rx_claim_supported( zuart ) ) {
+    zuart->err = ZUART_ERR;
+    return 0;
+  }
+
+  int sem_ret = 0;
+  uint32_t claimed;
+
+  while ( ( claimed = ring_buf_get_claim( &zuart->rx_rbuf, data, size ) ) == 0 ) {
+    sem_ret = _rx_sem_take( zuart, deadline );
+    if ( sem_ret < 0 ) break;
+  }
+
+  _rx_update_err( zuart, deadline, sem_ret );
+
+  return claimed;
+}
+
+uint32_t zuart_rx_peek( zuart_t *zuart, uint8_t *out_buf, uint32_t size ) {
+  
+  if ( !zuart_rx_claim_supported( zuart ) ) {
+    zuart->err = ZUART_ERR;
+    return 0;
+  }
+
+  return ring_buf_peek( &zuart->rx_rbuf, out_buf, size );
+}
+
+zuart_err_t zuart_rx_finish( zuart_t *zuart, uint32_t size ) {
+
+  if ( !zuart_rx_claim_supported( zuart ) 
+      || ring_buf_get_finish( &zuart->rx_rbuf, size ) != 0 ) {
+    zuart->err = ZUART_ERR;
+    return ZUART_ERR;
+  }
+
+  return ZUART_OK;
+}
+
 // TODO: https://glab.lromeraj.net/ucm/miot/tfm/iridium-sbd-library/-/issues/10
 uint32_t zuart_drain( zuart_t *zuart ) {
 
@@ -245,6 +612,47 @@ uint32_t zuart_drain( zuart_t *zuart ) {
   return size;
 }
 
+zuart_err_t zuart_set_baudrate( zuart_t *zuart, uint32_t baudrate ) {
+
+  struct uart_config config;
+
+  if ( baudrate == 0 
+      || uart_config_get( zuart->dev, &config ) != 0 ) {
+    zuart->err = ZUART_ERR;
+    return ZUART_ERR;
+  }
+
+  config.baudrate = baudrate;
+
+  if ( uart_configure( zuart->dev, &config ) != 0 ) {
+    zuart->err = ZUART_ERR;
+    return ZUART_ERR;
+  }
+
+  // character based timings depend on the baudrate
+  if ( zuart->config.read_proto == zuart_read_irq_proto ) {
+
+    zuart->rx_idle_timeout = _rx_idle_timeout( zuart );
+
+    if ( zuart->config.mode == ZUART_MODE_TIMER ) {
+      
+      k_timeout_t period;
+      zuart_err_t ret = _rx_poll_period( zuart, &period );
+      
+      // ! The UART is sampled as fast as possible anyway, 
+      // ! but received bytes may be dropped
+      k_timer_start( &zuart->rx_poll_timer, period, period );
+      
+      if ( ret != ZUART_OK ) {
+        zuart->err = ret;
+        return ret;
+      }
+    }
+  }
+
+  return ZUART_OK;
+}
+
 zuart_err_t zuart_setup( zuart_t *zuart, const zuart_config_t *zuart_config ) {
 
   // copy device pointer
@@ -263,10 +671,31 @@ zuart_err_t zuart_setup( zuart_t *zuart, const zuart_config_t *zuart_config ) {
     zuart->config.read_proto = zuart_read_poll_proto;
     zuart->config.write_proto = zuart_write_poll_proto;
 
+  } else if ( zuart_config->mode == ZUART_MODE_ASYNC ) {
+
+  #ifdef CONFIG_Z_UART_ASYNC
+    // received chunks are stored in the reception ring buffer
+    // so the interrupt read prototype can be reused
+    zuart->config.read_proto = zuart_read_irq_proto;
+    zuart->config.write_proto = zuart_write_async_proto;
+  #else
+    return ZUART_ERR_SETUP;
+  #endif
+
+  } else if ( zuart_config->mode == ZUART_MODE_TIMER ) {
+
+    // received bytes are stored in the reception ring buffer
+    // so the interrupt read prototype can be reused
+    zuart->config.read_proto = zuart_read_irq_proto;
+    zuart->config.write_proto = zuart_write_poll_proto;
+
   }
 
-  if ( zuart->config.read_proto == zuart_read_irq_proto 
-      || zuart->config.write_proto == zuart_write_irq_proto ) {
+  bool async = zuart->config.mode == ZUART_MODE_ASYNC;
+  bool timer = zuart->config.mode == ZUART_MODE_TIMER;
+
+  if ( !async && !timer && ( zuart->config.read_proto == zuart_read_irq_proto 
+      || zuart->config.write_proto == zuart_write_irq_proto ) ) {
 
     uart_irq_callback_user_data_set( zuart->dev, _uart_isr, zuart );
   }
@@ -282,22 +711,41 @@ zuart_err_t zuart_setup( zuart_t *zuart, const zuart_config_t *zuart_config ) {
 
     ring_buf_init(
       &zuart->rx_rbuf, zuart->config.rx_buf_size, zuart->config.rx_buf );    
+
+    _rx_wake_setup( zuart );
     
-    uart_irq_rx_enable( zuart->dev );
+    if ( timer ) {
+      if ( _rx_poll_timer_setup( zuart ) != ZUART_OK ) {
+        return ZUART_ERR_SETUP;
+      }
+    } else if ( !async ) {
+      uart_irq_rx_enable( zuart->dev );
+    }
   } 
 
-  if ( zuart->config.write_proto == zuart_write_irq_proto ) {
+  if ( zuart->config.write_proto == zuart_write_irq_proto || async ) {
 
     if ( zuart->config.tx_buf == NULL || zuart->config.tx_buf_size == 0 ) {
       return ZUART_ERR_SETUP;
     }
 
+    if ( zuart->config.tx_low_watermark == 0 
+        || zuart->config.tx_low_watermark >= zuart->config.tx_buf_size ) {
+      zuart->config.tx_low_watermark = zuart->config.tx_buf_size / 2;
+    }
+
     k_sem_init(
       &zuart->tx_sem, 0, 1 );
 
     ring_buf_init(
       &zuart->tx_rbuf, zuart->config.tx_buf_size, zuart->config.tx_buf );
   }
+
+#ifdef CONFIG_Z_UART_ASYNC
+  if ( async ) {
+    return _uart_async_setup( zuart );
+  }
+#endif
   
   return ZUART_OK;
 }
@@ -311,36 +759,202 @@ void zuart_force_read_timeout( zuart_t *zuart ) {
 
 // TODO: think about polling, update zuart struct flag ???
 void zuart_force_write_timeout( zuart_t *zuart ) {
-  if ( zuart->config.write_proto == zuart_write_irq_proto ) {
+  if ( zuart->config.write_proto == zuart_write_irq_proto 
+      || zuart->config.mode == ZUART_MODE_ASYNC ) {
     k_sem_reset( &zuart->tx_sem );
   }
 }
 
-static inline void _uart_tx_isr( const struct device *dev, zuart_t *zuart ) {
+void zuart_stats_get( zuart_t *zuart, zuart_stats_t *stats ) {
+#ifdef CONFIG_Z_UART_STATS
+  unsigned int key = irq_lock();
+  *stats = zuart->stats;
+  irq_unlock( key );
+#else
+  memset( stats, 0, sizeof( *stats ) );
+#endif
+}
 
-  if ( ring_buf_size_get( &zuart->tx_rbuf ) > 0 ) {
-    
-    uint8_t byte;
+void zuart_stats_reset( zuart_t *zuart ) {
+#ifdef CONFIG_Z_UART_STATS
+  unsigned int key = irq_lock();
+  memset( &zuart->stats, 0, sizeof( zuart->stats ) );
+  irq_unlock( key );
+#endif
+}
+
+static int _rx_sem_take( zuart_t *zuart, k_timepoint_t deadline ) {
+  
+  // remaining time is recomputed for every wait, so the
+  // deadline is never extended by intermediate wake ups
+  k_timeout_t timeout = sys_timepoint_timeout( deadline );
+
+#ifdef CONFIG_Z_UART_STATS
+  int64_t ts = k_uptime_ticks();
+  int ret = k_sem_take( &zuart->rx_sem, timeout );
+  zuart->stats.rx_wait_ticks += k_uptime_ticks() - ts;
+  return ret;
+#else
+  return k_sem_take( &zuart->rx_sem, timeout );
+#endif
+}
+
+static int _tx_sem_take( zuart_t *zuart, k_timepoint_t deadline ) {
+  
+  k_timeout_t timeout = sys_timepoint_timeout( deadline );
+
+#ifdef CONFIG_Z_UART_STATS
+  int64_t ts = k_uptime_ticks();
+  int ret = k_sem_take( &zuart->tx_sem, timeout );
+  zuart->stats.tx_wait_ticks += k_uptime_ticks() - ts;
+  return ret;
+#else
+  return k_sem_take( &zuart->tx_sem, timeout );
+#endif
+}
+
+static void _rx_update_err( zuart_t *zuart, k_timepoint_t deadline, int sem_ret ) {
+  if ( GET_FLAG( zuart->flags, FLAG_OVERRUN ) ) {
+    zuart->err = ZUART_ERR_OVERRUN;
+    CLEAR_FLAG( zuart->flags, FLAG_OVERRUN );
+  } else if ( !DEADLINE_IS_NO_WAIT( deadline ) && sem_ret ) {
+    zuart->err = ZUART_ERR_TIMEOUT;
+    STATS_ADD( zuart, rx_timeouts, 1 );
+  }
+}
 
-    // get byte from ring buffer
-    ring_buf_get( &zuart->tx_rbuf, &byte, 1 );
+/**
+ * @brief Computes the time needed to transfer a single character
+ * with the current UART configuration
+ */
+static uint32_t _char_time_us( zuart_t *zuart ) {
 
-    // ! We don't have a function to know the remaining space
-    // ! of the uart fifo, we only know that there is enough space for at least one byte
+  struct uart_config config;
 
-    // send byte to uart fifo
-    uart_fifo_fill( dev, &byte, 1 ); 
+  // bits per character: start + data + parity + stop
+  uint32_t char_bits = 10;
+  uint32_t baudrate = 19200;
 
-    // is theoretically impossible to receive value lower than 1
-    // due to the previous check using uart_irq_tx_ready(), 
-    // otherwise is a driver fault
+  if ( uart_config_get( zuart->dev, &config ) == 0 && config.baudrate > 0 ) {
+    
+    baudrate = config.baudrate;
     
-    // TODO: we could add extra logic here and give semaphore only if
-    // TODO: there are at least N bytes of free space in the ring buffer
-    // the semaphore will be given anyway to allow writing
+    char_bits = 1 + ( 5 + config.data_bits ) 
+      + ( config.parity != UART_CFG_PARITY_NONE ? 1 : 0 )
+      + ( config.stop_bits >= UART_CFG_STOP_BITS_1_5 ? 2 : 1 );
+  }
+
+  return DIV_ROUND_UP( char_bits * USEC_PER_SEC, baudrate );
+}
+
+static k_timeout_t _rx_idle_timeout( zuart_t *zuart ) {
+
+  uint32_t idle_us = 
+    zuart->config.rx_wake.idle_chars * _char_time_us( zuart );
+
+  return K_USEC( idle_us > 0 ? idle_us : 1 );
+}
+
+static zuart_err_t _rx_poll_period( zuart_t *zuart, k_timeout_t *period ) {
+
+  uint32_t fifo_us = CONFIG_Z_UART_TIMER_FIFO_DEPTH * _char_time_us( zuart );
+
+  // ! Timers can not expire more often than the kernel tick, 
+  // ! so the period is computed in ticks and checked afterwards
+  uint32_t ticks = MAX( k_us_to_ticks_ceil32( fifo_us / 2 ), 1 );
+
+  *period = K_TICKS( ticks );
+
+  if ( k_ticks_to_us_ceil32( ticks ) >= fifo_us ) {
+    return ZUART_ERR_SETUP;
+  }
+
+  return ZUART_OK;
+}
+
+static void _rx_wake_setup( zuart_t *zuart ) {
+
+  zuart->rx_idle_timeout = _rx_idle_timeout( zuart );
+
+  k_timer_init( &zuart->rx_idle_timer, _rx_idle_expired, NULL );
+}
+
+static zuart_err_t _rx_poll_timer_setup( zuart_t *zuart ) {
+
+  k_timeout_t period;
+
+  if ( _rx_poll_period( zuart, &period ) != ZUART_OK ) {
+    return ZUART_ERR_SETUP;
+  }
+
+  k_timer_init( &zuart->rx_poll_timer, _rx_poll_timer_expired, NULL );
+  k_timer_start( &zuart->rx_poll_timer, period, period );
+
+  return ZUART_OK;
+}
+
+static void _rx_idle_expired( struct k_timer *timer ) {
+  
+  zuart_t *zuart = CONTAINER_OF( timer, zuart_t, rx_idle_timer );
+
+  if ( !ring_buf_is_empty( &zuart->rx_rbuf ) ) {
+    k_sem_give( &zuart->rx_sem );
+  }
+}
+
+static void _uart_irq_tx_start( zuart_t *zuart ) {
+  // enable irq to transmit ring buffer
+  uart_irq_tx_enable( zuart->dev );
+}
+
+/**
+ * @brief Signals writers waiting for space in the transmission ring buffer, 
+ * but only if the pending bytes have dropped to the configured low watermark
+ */
+static inline void _uart_tx_notify( zuart_t *zuart ) {
+  if ( ring_buf_size_get( &zuart->tx_rbuf ) <= zuart->config.tx_low_watermark ) {
     k_sem_give( &zuart->tx_sem );
+  }
+}
 
-  } else {
+static inline void _uart_tx_isr( const struct device *dev, zuart_t *zuart ) {
+
+  int bytes_sent;
+  uint8_t *tx_data;
+  uint32_t tx_len;
+  uint32_t total_bytes_sent = 0;
+
+  // fill as much of the hardware FIFO as the driver accepts
+  do {
+
+    tx_len = ring_buf_get_claim( 
+      &zuart->tx_rbuf, &tx_data, zuart->config.tx_buf_size );
+
+    if ( tx_len == 0 ) {
+      break;
+    }
+
+    bytes_sent = uart_fifo_fill( dev, tx_data, tx_len );
+
+    if ( bytes_sent < 0 ) {
+      bytes_sent = 0;
+    }
+
+    ring_buf_get_finish( &zuart->tx_rbuf, bytes_sent );
+
+    total_bytes_sent += bytes_sent;
+
+    // the claimed region may end at the edge of the ring buffer,
+    // so if it was completely sent we have to claim again
+  } while ( bytes_sent == tx_len );
+
+  if ( total_bytes_sent > 0 ) {
+
+    STATS_ADD( zuart, tx_bytes, total_bytes_sent );
+
+    _uart_tx_notify( zuart );
+
+  } else if ( ring_buf_is_empty( &zuart->tx_rbuf ) ) {
   
     // ! This may cause _uart_tx_isr() to be unnecessary over-called
     // ! This has been fixed by allowing interrupt to exit multiple times
@@ -363,20 +977,140 @@ static inline void _uart_tx_isr( const struct device *dev, zuart_t *zuart ) {
   }
 }
 
-static inline void _uart_rx_isr( const struct device *dev, zuart_t *zuart ) {
+static inline bool _rx_has_delim( zuart_t *zuart, const uint8_t *data, uint32_t len ) {
+  return ( zuart->config.rx_wake.policy & ZUART_RX_WAKE_DELIM )
+    && memchr( data, zuart->config.rx_wake.delim, len ) != NULL;
+}
+
+/**
+ * @brief Signals readers waiting for received bytes depending on
+ * the configured wake up policy
+ * 
+ * @param delim A delimiter byte was received in the last chunk
+ */
+static inline void _uart_rx_notify( zuart_t *zuart, bool delim ) {
+
+  const zuart_rx_wake_t *wake = &zuart->config.rx_wake;
+
+  bool give = wake->policy == ZUART_RX_WAKE_ANY 
+    || delim 
+    || ring_buf_space_get( &zuart->rx_rbuf ) == 0;
+
+  if ( !give && ( wake->policy & ZUART_RX_WAKE_BYTES ) ) {
+    give = ring_buf_size_get( &zuart->rx_rbuf ) >= wake->bytes;
+  }
+
+  if ( give ) {
+    k_sem_give( &zuart->rx_sem );
+  }
+
+  if ( wake->policy & ZUART_RX_WAKE_IDLE ) {
+    if ( give ) {
+      k_timer_stop( &zuart->rx_idle_timer );
+    } else {
+      // restart idle gap
+      k_timer_start( &zuart->rx_idle_timer, zuart->rx_idle_timeout, K_NO_WAIT );
+    }
+  }
+
+}
+
+/**
+ * @brief Drains the hardware FIFO into the reception ring buffer
+ * 
+ * @param fifo_read Function used to read from the hardware FIFO
+ */
+static inline void _rx_drain( 
+  const struct device *dev, zuart_t *zuart, 
+  int (*fifo_read)( const struct device *dev, uint8_t *buf, const int size ) 
+) {
   
-  uint8_t byte;
+  int bytes_read;
+  bool delim = false;
+  uint8_t *rx_data;
+  uint32_t rx_space;
+  uint32_t total_bytes_read = 0;
   
-  if ( uart_fifo_read( dev, &byte, sizeof( byte ) ) == sizeof( byte ) ) {
+  // drain the whole hardware FIFO in one go, directly
+  // into the free space of the reception ring buffer
+  do {
+
+    rx_space = ring_buf_put_claim( 
+      &zuart->rx_rbuf, &rx_data, zuart->config.rx_buf_size );
+
+    if ( rx_space == 0 ) {
+      break;
+    }
+
+    bytes_read = fifo_read( dev, rx_data, rx_space );
+    
+    if ( bytes_read < 0 ) {
+      bytes_read = 0;
+    }
+
+    delim = delim || _rx_has_delim( zuart, rx_data, bytes_read );
+
+    ring_buf_put_finish( &zuart->rx_rbuf, bytes_read );
+
+    total_bytes_read += bytes_read;
+
+    // the claimed region may end at the edge of the ring buffer,
+    // so if it was completely filled we have to claim again
+  } while ( bytes_read == rx_space );
+
+  if ( rx_space == 0 ) {
     
-    if ( ring_buf_put( &zuart->rx_rbuf, &byte, sizeof( byte ) ) == 0 ) {
+    uint8_t byte;
+
+    // ! There is no space left in the ring buffer, the remaining
+    // ! bytes have to be pulled out anyway, otherwise the interrupt
+    // ! would be triggered again and again
+    if ( fifo_read( dev, &byte, sizeof( byte ) ) > 0 ) {
+
+      uint32_t dropped = 1;
+
+      while ( fifo_read( dev, &byte, sizeof( byte ) ) > 0 ) {
+        dropped++;
+      }
+      
       SET_FLAG( zuart->flags, FLAG_OVERRUN );
+      STATS_ADD( zuart, rx_dropped, dropped );
     }
 
-    // TODO: we could give semaphore depending on some additional logic
-    k_sem_give( &zuart->rx_sem );
   }
 
+  if ( total_bytes_read > 0 ) {
+    STATS_ADD( zuart, rx_bytes, total_bytes_read );
+    STATS_PEAK( zuart, rx_peak, ring_buf_size_get( &zuart->rx_rbuf ) );
+    _uart_rx_notify( zuart, delim );
+  }
+
+}
+
+static inline void _uart_rx_isr( const struct device *dev, zuart_t *zuart ) {
+  _rx_drain( dev, zuart, uart_fifo_read );
+}
+
+/**
+ * @brief Reads from the UART using polling technique,
+ * with the same semantics as uart_fifo_read()
+ */
+static int _poll_fifo_read( const struct device *dev, uint8_t *buf, const int size ) {
+  
+  int bytes_read = 0;
+  
+  while ( bytes_read < size && uart_poll_in( dev, &buf[ bytes_read ] ) == 0 ) {
+    bytes_read++;
+  }
+
+  return bytes_read;
+}
+
+static void _rx_poll_timer_expired( struct k_timer *timer ) {
+
+  zuart_t *zuart = CONTAINER_OF( timer, zuart_t, rx_poll_timer );
+
+  _rx_drain( zuart->dev, zuart, _poll_fifo_read );
 }
 
 static void _uart_isr( const struct device *dev, void *user_data ) {
@@ -387,6 +1121,8 @@ static void _uart_isr( const struct device *dev, void *user_data ) {
 
   zuart_t *zuart = (zuart_t*)user_data;
 
+  STATS_ADD( zuart, isr_calls, 1 );
+
   if ( uart_irq_rx_ready( dev ) ) {
     _uart_rx_isr( dev, zuart );
   }
@@ -395,4 +1131,127 @@ static void _uart_isr( const struct device *dev, void *user_data ) {
     _uart_tx_isr( dev, zuart );
   }
 
-}
\ No newline at end of file
+}
+
+#ifdef CONFIG_Z_UART_ASYNC
+
+static zuart_err_t _uart_async_setup( zuart_t *zuart ) {
+
+  atomic_set( &zuart->async.tx_busy, 0 );
+
+  if ( uart_callback_set( zuart->dev, _uart_async_cb, zuart ) != 0 ) {
+    return ZUART_ERR_SETUP;
+  }
+
+  // the second buffer will be handed on UART_RX_BUF_REQUEST
+  zuart->async.rx_buf_idx = 1;
+
+  if ( uart_rx_enable( 
+      zuart->dev, 
+      zuart->async.rx_buf[ 0 ], sizeof( zuart->async.rx_buf[ 0 ] ), 
+      CONFIG_Z_UART_ASYNC_RX_TIMEOUT ) != 0 ) {
+    return ZUART_ERR_SETUP;
+  }
+
+  return ZUART_OK;
+}
+
+static void _uart_async_tx_start( zuart_t *zuart ) {
+
+  // only one DMA transfer at a time, if a transfer is in progress
+  // the remaining data will be sent after UART_TX_DONE
+  if ( !atomic_cas( &zuart->async.tx_busy, 0, 1 ) ) {
+    return;
+  }
+
+  uint8_t *data;
+  uint32_t len = ring_buf_get_claim( 
+    &zuart->tx_rbuf, &data, zuart->config.tx_buf_size );
+
+  if ( len > 0 && uart_tx( zuart->dev, data, len, SYS_FOREVER_US ) == 0 ) {
+    return;
+  }
+
+  // nothing to transmit or the driver refused the transfer,
+  // in both cases the claimed region is released
+  ring_buf_get_finish( &zuart->tx_rbuf, 0 );
+  atomic_set( &zuart->async.tx_busy, 0 );
+}
+
+static void _uart_async_cb( const struct device *dev, struct uart_event *evt, void *user_data ) {
+
+  zuart_t *zuart = (zuart_t*)user_data;
+
+  STATS_ADD( zuart, isr_calls, 1 );
+
+  switch ( evt->type ) {
+
+    case UART_TX_DONE:
+    case UART_TX_ABORTED:
+      
+      // release transmitted bytes and keep transmitting
+      // the remaining ones (if any)
+      ring_buf_get_finish( &zuart->tx_rbuf, evt->data.tx.len );
+      atomic_set( &zuart->async.tx_busy, 0 );
+
+      STATS_ADD( zuart, tx_bytes, evt->data.tx.len );
+      
+      _uart_tx_notify( zuart );
+      
+      _uart_async_tx_start( zuart );
+      break;
+
+    case UART_RX_RDY: {
+
+      uint32_t stored = ring_buf_put( 
+        &zuart->rx_rbuf, 
+        evt->data.rx.buf + evt->data.rx.offset, 
+        evt->data.rx.len );
+
+      if ( stored < evt->data.rx.len ) {
+        SET_FLAG( zuart->flags, FLAG_OVERRUN );
+        STATS_ADD( zuart, rx_dropped, evt->data.rx.len - stored );
+      }
+
+      STATS_ADD( zuart, rx_bytes, stored );
+      STATS_PEAK( zuart, rx_peak, ring_buf_size_get( &zuart->rx_rbuf ) );
+
+      _uart_rx_notify( zuart, _rx_has_delim( 
+        zuart, evt->data.rx.buf + evt->data.rx.offset, evt->data.rx.len ) );
+      break;
+    }
+
+    case UART_RX_BUF_REQUEST:
+      
+      uart_rx_buf_rsp( dev, 
+        zuart->async.rx_buf[ zuart->async.rx_buf_idx ], 
+        sizeof( zuart->async.rx_buf[ 0 ] ) );
+      
+      zuart->async.rx_buf_idx ^= 1;
+      break;
+
+    case UART_RX_STOPPED:
+
+      if ( evt->data.rx_stop.reason & UART_ERROR_OVERRUN ) {
+        SET_FLAG( zuart->flags, FLAG_OVERRUN );
+      }
+      break;
+
+    case UART_RX_DISABLED:
+
+      // ! Reception is disabled by the driver after an error,
+      // ! so it has to be enabled again
+      zuart->async.rx_buf_idx = 1;
+      
+      uart_rx_enable( dev, 
+        zuart->async.rx_buf[ 0 ], sizeof( zuart->async.rx_buf[ 0 ] ), 
+        CONFIG_Z_UART_ASYNC_RX_TIMEOUT );
+      break;
+
+    default:
+      break;
+  }
+
+}
+
+#endif
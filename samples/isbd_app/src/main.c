@@ -117,10 +117,13 @@ int main(void) {
     .at_uart = {
       .echo = true,
       .verbose = true,
+      // .baudrate = 115200, // negotiated with the ISU using AT+IPR
+      .batch = true, // apply basic settings using as few command lines as possible
       // .zuart = ZUART_CONF_POLL( uart_960x_device ),
       .zuart = ZUART_CONF_IRQ( uart_960x_device, rx_buf, sizeof( rx_buf ), tx_buf, sizeof( tx_buf ) ),
       // .zuart = ZUART_CONF_MIX_RX_IRQ_TX_POLL( uart_960x_device, rx_buf, sizeof( rx_buf ) ),
       // .zuart = ZUART_CONF_MIX_RX_POLL_TX_IRQ( uart_960x_device, tx_buf, sizeof( tx_buf ) ),
+      // .zuart = ZUART_CONF_ASYNC( uart_960x_device, rx_buf, sizeof( rx_buf ), tx_buf, sizeof( tx_buf ) ), // requires CONFIG_Z_UART_ASYNC=y
     }
   };
   
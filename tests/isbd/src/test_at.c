@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#include "at.h"
+
+#define BENCH_ITERATIONS    1000
+
+static const char *g_sbdix_lines[] = {
+  "+SBDIX: 0, 12, 1, 3, 120, 0",
+  "+SBDIX:32,65535,2,0,0,0",
+  "+SBDIX: 18, 4, 0, 0, 0, 7",
+};
+
+static const uint16_t g_sbdix_max[] = {
+  UINT8_MAX, UINT16_MAX, UINT8_MAX, UINT16_MAX, UINT16_MAX, UINT8_MAX };
+
+static int _sbdix_sscanf( const char *line, uint16_t *fields ) {
+
+  uint8_t mo_sts, mt_sts, mt_queued;
+  uint16_t mo_msn, mt_msn, mt_len;
+
+  int read = sscanf( line, "+SBDIX:%hhu,%hu,%hhu,%hu,%hu,%hhu",
+    &mo_sts, &mo_msn, &mt_sts, &mt_msn, &mt_len, &mt_queued );
+
+  fields[ 0 ] = mo_sts;
+  fields[ 1 ] = mo_msn;
+  fields[ 2 ] = mt_sts;
+  fields[ 3 ] = mt_msn;
+  fields[ 4 ] = mt_len;
+  fields[ 5 ] = mt_queued;
+
+  return read;
+}
+
+static int _sbdix_parse( const char *line, uint16_t *fields ) {
+  return at_parse_uints(
+    line, "+SBDIX:", fields, g_sbdix_max, ARRAY_SIZE( g_sbdix_max ) );
+}
+
+static uint32_t _bench( int (*parse)( const char*, uint16_t* ) ) {
+
+  uint16_t fields[ ARRAY_SIZE( g_sbdix_max ) ];
+  uint32_t start = k_cycle_get_32();
+
+  for ( int i = 0; i < BENCH_ITERATIONS; i++ ) {
+    parse( g_sbdix_lines[ i % ARRAY_SIZE( g_sbdix_lines ) ], fields );
+  }
+
+  return k_cycle_get_32() - start;
+}
+
+ZTEST( at_suite, test_parse_uints_matches_sscanf ) {
+
+  for ( int i = 0; i < ARRAY_SIZE( g_sbdix_lines ); i++ ) {
+
+    uint16_t ref[ ARRAY_SIZE( g_sbdix_max ) ];
+    uint16_t fields[ ARRAY_SIZE( g_sbdix_max ) ];
+
+    zassert_equal( _sbdix_sscanf( g_sbdix_lines[ i ], ref ), 6, "sscanf failed" );
+    zassert_equal( _sbdix_parse( g_sbdix_lines[ i ], fields ), 6, "Parser failed" );
+    zassert_mem_equal( fields, ref, sizeof( ref ), "Fields mismatch" );
+  }
+}
+
+ZTEST( at_suite, test_parse_uints_errors ) {
+
+  uint16_t fields[ 2 ];
+  static const uint16_t max[] = { UINT8_MAX, UINT8_MAX };
+
+  zassert_equal( at_parse_uints( "+CSQ:5", "+CIEV:", fields, max, 2 ), 0,
+    "Prefix mismatch not detected" );
+  zassert_equal( at_parse_uints( "+CIEV:0", "+CIEV:", fields, max, 2 ), 1,
+    "Missing field not detected" );
+  zassert_equal( at_parse_uints( "+CIEV:0,256", "+CIEV:", fields, max, 2 ), 1,
+    "Out of range field not detected" );
+  zassert_equal( at_parse_uints( "+CIEV:0;1", "+CIEV:", fields, max, 2 ), 1,
+    "Bad separator not detected" );
+  zassert_equal( at_parse_uints( "+CIEV:1,5", "+CIEV:", fields, max, 2 ), 2,
+    "Valid line not parsed" );
+  zassert_equal( fields[ 1 ], 5, "Wrong field value" );
+}
+
+ZTEST( at_suite, test_parse_uints_bench ) {
+
+  uint32_t sscanf_cycles = _bench( _sbdix_sscanf );
+  uint32_t parse_cycles = _bench( _sbdix_parse );
+
+  TC_PRINT( "+SBDIX x%d: sscanf %u cycles, at_parse_uints %u cycles\n",
+    BENCH_ITERATIONS, sscanf_cycles, parse_cycles );
+}
+
+ZTEST_SUITE( at_suite, NULL, NULL, NULL, NULL, NULL );
@@ -0,0 +1,138 @@
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+
+#include "at_uart.h"
+
+#define EMUL_UART_NODE        DT_NODELABEL( euart0 )
+#define EMUL_UART_DEVICE      DEVICE_DT_GET( EMUL_UART_NODE )
+
+#define MODEM_LINE_SIZE       64
+
+static uint8_t rx_buf[ 128 ];
+static uint8_t tx_buf[ 128 ];
+
+static at_uart_config_t g_at_uart_config = {
+  .echo = true,
+  .verbose = false,
+  .zuart = ZUART_CONF_IRQ( (struct device*)EMUL_UART_DEVICE, rx_buf, sizeof( rx_buf ), tx_buf, sizeof( tx_buf ) ),
+};
+
+static at_uart_t g_at_uart;
+
+static const char *const g_urcs[] = { "+CIEV:", "+AREG:", "126" };
+
+/**
+ * @brief Minimal modem, every command line is echoed and answered with OK
+ */
+static struct {
+  uint8_t line[ MODEM_LINE_SIZE ];
+  uint16_t line_len;
+  const char *lead; // sent once ahead of the next echo
+} g_modem;
+
+static struct {
+  char line[ 32 ];
+  uint8_t count;
+} g_urc;
+
+static void _modem_tx_ready( const struct device *dev, size_t size, void *user_data ) {
+
+  uint8_t byte;
+
+  while ( uart_emul_get_tx_data( dev, &byte, 1 ) == 1 ) {
+
+    if ( g_modem.line_len < sizeof( g_modem.line ) ) {
+      g_modem.line[ g_modem.line_len++ ] = byte;
+    }
+
+    if ( byte != '\r' ) {
+      continue;
+    }
+
+    if ( g_modem.lead ) {
+      uart_emul_put_rx_data( 
+        dev, (const uint8_t*)g_modem.lead, strlen( g_modem.lead ) );
+      g_modem.lead = NULL;
+    }
+
+    uart_emul_put_rx_data( dev, g_modem.line, g_modem.line_len );
+    uart_emul_put_rx_data( dev, (const uint8_t*)"0\r", 2 );
+
+    g_modem.line_len = 0;
+  }
+}
+
+static void _urc_handler( 
+  at_uart_t *at_uart, const char *line, uint16_t len, void *user_data 
+) {
+  strncpy( g_urc.line, line, sizeof( g_urc.line ) - 1 );
+  g_urc.count++;
+}
+
+static void* at_uart_suite_setup(void) {
+
+  uart_emul_callback_tx_data_ready_set( EMUL_UART_DEVICE, _modem_tx_ready, NULL );
+
+  at_uart_err_t ret = at_uart_setup( &g_at_uart, &g_at_uart_config );
+
+  zassert_equal( ret, AT_UART_OK, "Setup failed" );
+
+  at_uart_set_urc_handler( 
+    &g_at_uart, g_urcs, ARRAY_SIZE( g_urcs ), _urc_handler, NULL );
+
+  return NULL;
+}
+
+static void at_uart_suite_before( void *f ) {
+  memset( &g_urc, 0, sizeof( g_urc ) );
+}
+
+ZTEST_SUITE( at_uart_suite, NULL, at_uart_suite_setup, at_uart_suite_before, NULL, NULL );
+
+
+ZTEST( at_uart_suite, test_urc_before_echo ) {
+
+  // ring alert received while the command was being sent
+  g_modem.lead = "126\r";
+
+  at_uart_err_t ret = at_uart_write_cmd( &g_at_uart, "AT\r", 3 );
+
+  zassert_equal( ret, AT_UART_OK, "Echo not accepted (%d)", ret );
+  zassert_equal( 
+    at_uart_skip_resp( &g_at_uart, AT_1_LINE_RESP, 1000 ), AT_UART_OK, 
+    "Response lost" );
+
+  zassert_equal( g_urc.count, 1, "URC not dispatched" );
+  zassert_mem_equal( g_urc.line, "126", 4, "Unexpected URC: %s", g_urc.line );
+}
+
+ZTEST( at_uart_suite, test_urc_line_before_echo ) {
+
+  // leading trailing chars are skipped too
+  g_modem.lead = "\r+CIEV:1,1\r";
+
+  at_uart_err_t ret = at_uart_write_cmd( &g_at_uart, "AT+CIER?\r", 9 );
+
+  zassert_equal( ret, AT_UART_OK, "Echo not accepted (%d)", ret );
+  zassert_equal( 
+    at_uart_skip_resp( &g_at_uart, AT_1_LINE_RESP, 1000 ), AT_UART_OK, 
+    "Response lost" );
+
+  zassert_equal( g_urc.count, 1, "URC not dispatched" );
+  zassert_mem_equal( g_urc.line, "+CIEV:1,1", 10, "Unexpected URC: %s", g_urc.line );
+}
+
+ZTEST( at_uart_suite, test_corrupted_echo ) {
+
+  // not an URC, the first echoed byte has been corrupted
+  g_modem.lead = "X";
+
+  at_uart_err_t ret = at_uart_write_cmd( &g_at_uart, "AT\r", 3 );
+
+  zassert_equal( ret, AT_UART_ECHO, "Corrupted echo accepted (%d)", ret );
+  zassert_equal( g_urc.count, 0, "Unexpected URC" );
+}
@@ -139,6 +139,85 @@ ZTEST( isbd_suite, test_mo_mt ) {
 
 }
 
+static uint16_t _mo_producer( 
+  uint8_t *buf, uint16_t offset, uint16_t size, void *user_data 
+) {
+  // the message is generated on the fly, no buffer is needed
+  for ( uint16_t i = 0; i < size; i++ ) {
+    buf[ i ] = (uint8_t)( offset + i );
+  }
+  // a limit can be given to emulate a failing producer
+  if ( user_data && offset + size > *(uint16_t*)user_data ) {
+    return MAX( *(uint16_t*)user_data, offset ) - offset;
+  }
+  return size;
+}
+
+static void _mt_sink( 
+  const uint8_t *chunk, uint16_t offset, uint16_t len, void *user_data 
+) {
+  uint16_t *mismatches = user_data;
+
+  for ( uint16_t i = 0; i < len; i++ ) {
+    if ( chunk[ i ] != (uint8_t)( offset + i ) ) {
+      (*mismatches)++;
+    }
+  }
+}
+
+ZTEST( isbd_suite, test_mo_mt_stream ) {
+
+  isu_dte_err_t ret;
+  const uint16_t msg_len = 100; // spans several chunks
+
+  ret = isu_set_mo_stream( &g_isu_dte, msg_len, _mo_producer, NULL );
+
+  zassert_equal( ret, ISU_DTE_OK, 
+    "Could not stream MO buffer" );
+
+  ret = isu_mo_to_mt( &g_isu_dte, NULL, 0 );
+
+  zassert_equal( ret, ISU_DTE_OK, 
+    "Could not transfer message from MO to MT" );
+
+  uint16_t mt_len;
+  uint16_t mismatches = 0;
+
+  ret = isu_get_mt_stream( &g_isu_dte, msg_len, _mt_sink, &mismatches, &mt_len );
+
+  zassert_equal( ret, ISU_DTE_OK, 
+    "Could not stream MT buffer" );
+  zassert_equal( mt_len, msg_len, 
+    "MT message length mismatch" );
+  zassert_equal( mismatches, 0, 
+    "MT message content mismatch" );
+
+  /**
+   * @brief Messages longer than the given maximum 
+   * must be skipped without calling the sink
+   */
+  ret = isu_get_mt_stream( &g_isu_dte, msg_len - 1, _mt_sink, NULL, &mt_len );
+
+  zassert_equal( ret, ISU_DTE_ERR_AT );
+  zassert_equal( isu_dte_get_err( &g_isu_dte ), AT_UART_OVERFLOW, 
+    "Overflow not triggered" );
+
+  /**
+   * @brief A producer coming up short must be reported
+   * and the message rejected by the ISU
+   */
+  uint16_t limit = msg_len / 2;
+  ret = isu_set_mo_stream( &g_isu_dte, msg_len, _mo_producer, &limit );
+
+  zassert_equal( ret, ISU_DTE_ERR_PRODUCER, 
+    "Producer failure not reported" );
+  zassert_equal( isu_dte_get_err( &g_isu_dte ), 2, 
+    "Message not rejected by the ISU" );
+
+  ret = isu_clear_buffer( &g_isu_dte, ISU_CLEAR_MO_MT_BUFF );
+  zassert_equal( ret, ISU_DTE_OK );
+}
+
 // TODO: move this to a new AT-UART test module
 ZTEST( isbd_suite, test_overflow ) {
 
@@ -0,0 +1,137 @@
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+
+#include "isbd/util.h"
+
+#define BENCH_ITERATIONS    1000
+
+#define MO_MAX_LEN          340
+#define MT_MAX_LEN          270
+
+// longer than the 256 words folded at once by the SWAR kernel
+#define FLUSH_TEST_LEN      1100
+
+typedef uint32_t (*sum_kernel_t)( const uint8_t *buf, uint16_t len );
+
+// an extra word is reserved to test misaligned buffers
+static uint8_t g_buf[ MO_MAX_LEN + sizeof( uint32_t ) ] __aligned( 4 );
+
+static void _fill_buf( uint8_t seed ) {
+  for ( uint16_t i = 0; i < sizeof( g_buf ); i++ ) {
+    g_buf[ i ] = (uint8_t)( i * 31 + seed );
+  }
+}
+
+static uint32_t _bench( sum_kernel_t kernel, const uint8_t *buf, uint16_t len ) {
+
+  volatile uint32_t sum = 0;
+  uint32_t start = k_cycle_get_32();
+
+  for ( int i = 0; i < BENCH_ITERATIONS; i++ ) {
+    sum += kernel( buf, len );
+  }
+
+  return k_cycle_get_32() - start;
+}
+
+static void _bench_len( uint16_t len ) {
+
+  uint32_t ref_cycles = _bench( isbd_util_sum_ref, g_buf, len );
+  uint32_t swar_cycles = _bench( isbd_util_sum_swar, g_buf, len );
+
+  TC_PRINT( "%u bytes x%d: ref %u cycles, swar %u cycles\n",
+    len, BENCH_ITERATIONS, ref_cycles, swar_cycles );
+
+#if defined( __ARM_FEATURE_SIMD32 )
+  uint32_t simd32_cycles = _bench( isbd_util_sum_simd32, g_buf, len );
+  
+  TC_PRINT( "%u bytes x%d: simd32 %u cycles\n",
+    len, BENCH_ITERATIONS, simd32_cycles );
+#endif
+
+}
+
+ZTEST( isbd_util_suite, test_kernels_match_ref ) {
+
+  for ( uint8_t seed = 0; seed < 2; seed++ ) {
+
+    if ( seed == 0 ) {
+      memset( g_buf, 0xFF, sizeof( g_buf ) );
+    } else {
+      _fill_buf( seed );
+    }
+
+    for ( uint8_t off = 0; off < sizeof( uint32_t ); off++ ) {
+      for ( uint16_t len = 0; len <= MO_MAX_LEN; len++ ) {
+
+        uint32_t ref = isbd_util_sum_ref( &g_buf[ off ], len );
+
+        zassert_equal( isbd_util_sum_swar( &g_buf[ off ], len ), ref, 
+          "SWAR mismatch, offset=%u, len=%u", off, len );
+
+#if defined( __ARM_FEATURE_SIMD32 )
+        zassert_equal( isbd_util_sum_simd32( &g_buf[ off ], len ), ref, 
+          "SIMD32 mismatch, offset=%u, len=%u", off, len );
+#endif
+      }
+    }
+
+  }
+}
+
+ZTEST( isbd_util_suite, test_kernels_lane_flush ) {
+
+  static uint8_t long_buf[ FLUSH_TEST_LEN + sizeof( uint32_t ) ] __aligned( 4 );
+
+  // all-ones bytes is the worst case for lane overflows
+  memset( long_buf, 0xFF, sizeof( long_buf ) );
+
+  for ( uint8_t off = 0; off < sizeof( uint32_t ); off++ ) {
+    for ( uint16_t len = 1020; len <= FLUSH_TEST_LEN; len++ ) {
+
+      uint32_t ref = isbd_util_sum_ref( &long_buf[ off ], len );
+
+      zassert_equal( isbd_util_sum_swar( &long_buf[ off ], len ), ref, 
+        "SWAR mismatch, offset=%u, len=%u", off, len );
+
+#if defined( __ARM_FEATURE_SIMD32 )
+      zassert_equal( isbd_util_sum_simd32( &long_buf[ off ], len ), ref, 
+        "SIMD32 mismatch, offset=%u, len=%u", off, len );
+#endif
+    }
+  }
+}
+
+ZTEST( isbd_util_suite, test_csum_incremental ) {
+
+  _fill_buf( 7 );
+
+  uint16_t expected = isbd_util_sum_ref( g_buf, MO_MAX_LEN ) & 0xFFFF;
+
+  zassert_equal( isbd_util_compute_checksum( g_buf, MO_MAX_LEN ), expected, 
+    "Checksum mismatch" );
+
+  // the result must not depend on how the message is split
+  for ( uint16_t chunk = 1; chunk <= 64; chunk++ ) {
+
+    isbd_util_csum_t csum;
+    isbd_util_csum_init( &csum );
+
+    for ( uint16_t off = 0; off < MO_MAX_LEN; off += chunk ) {
+      isbd_util_csum_update( &csum, &g_buf[ off ], MIN( chunk, MO_MAX_LEN - off ) );
+    }
+
+    zassert_equal( isbd_util_csum_final( &csum ), expected, 
+      "Incremental checksum mismatch, chunk=%u", chunk );
+  }
+}
+
+ZTEST( isbd_util_suite, test_csum_bench ) {
+
+  _fill_buf( 3 );
+
+  _bench_len( MO_MAX_LEN );
+  _bench_len( MT_MAX_LEN );
+}
+
+ZTEST_SUITE( isbd_util_suite, NULL, NULL, NULL, NULL, NULL );
@@ -1,3 +1,4 @@
+#include <string.h>
 #include <zephyr/ztest.h>
 #include <zephyr/kernel.h>
 #include <zephyr/device.h>
@@ -9,12 +10,162 @@
 #define ISBD_UART_NODE        DT_NODELABEL( uart1 )
 #define ISBD_UART_DEVICE      DEVICE_DT_GET( ISBD_UART_NODE )
 
+#define PEER_TIMEOUT_MS       1000
+#define PEER_BAUDRATE         115200
+
 struct zuart_suite_fixture {
   zuart_t zuart;
+  zuart_config_t config; // applied before every test
   uint8_t rx_buf[64];
   uint8_t tx_buf[64];
 };
 
+/**
+ * @brief Same pattern as the one sent by the peer, see zuart.py
+ */
+static void _pattern_fill( uint8_t *buf, uint32_t len, uint32_t offset ) {
+  for ( uint32_t i = 0; i < len; i++ ) {
+    buf[ i ] = 'a' + ( offset + i ) % 26;
+  }
+}
+
+static bool _pattern_check( const uint8_t *buf, uint32_t len, uint32_t offset ) {
+  for ( uint32_t i = 0; i < len; i++ ) {
+    if ( buf[ i ] != 'a' + ( offset + i ) % 26 ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void _fixture_apply( struct zuart_suite_fixture *fixture ) {
+  
+  zuart_err_t ret = zuart_setup( &fixture->zuart, &fixture->config );
+
+  zassert_equal( ret, ZUART_OK, "Setup error" );
+}
+
+/**
+ * @brief Sends a command line to the peer, see zuart.py
+ */
+static void _peer_cmd( zuart_t *zuart, const char *cmd ) {
+
+  uint16_t cmd_len = strlen( cmd );
+
+  zassert_equal( 
+    zuart_write( zuart, (const uint8_t*)cmd, cmd_len, PEER_TIMEOUT_MS ), cmd_len,
+    "Could not send command: %s", cmd );
+}
+
+/**
+ * @brief Waits until the peer is ready
+ */
+static void _peer_sync( zuart_t *zuart ) {
+
+  uint8_t byte;
+
+  do {
+    _peer_cmd( zuart, "ping\n" );
+  } while ( zuart_read( zuart, &byte, 1, PEER_TIMEOUT_MS ) != 1 );
+
+  // answers to previous pings may still be arriving
+  k_msleep( 20 );
+  zuart_drain( zuart );
+}
+
+/**
+ * @brief Waits until the given number of bytes 
+ * has been stored in the reception ring buffer
+ */
+static bool _wait_available( zuart_t *zuart, uint16_t n_bytes ) {
+
+  k_timepoint_t deadline = sys_timepoint_calc( K_MSEC( PEER_TIMEOUT_MS ) );
+
+  while ( zuart_available( zuart ) < n_bytes ) {
+    if ( sys_timepoint_expired( deadline ) ) {
+      return false;
+    }
+    k_msleep( 1 );
+  }
+
+  return true;
+}
+
+/**
+ * @brief Waits until the transmission ring buffer has been 
+ * completely handed to the UART
+ */
+static bool _wait_tx_done( zuart_t *zuart ) {
+
+  k_timepoint_t deadline = sys_timepoint_calc( K_MSEC( PEER_TIMEOUT_MS ) );
+
+  while ( !ring_buf_is_empty( &zuart->tx_rbuf ) ) {
+    if ( sys_timepoint_expired( deadline ) ) {
+      return false;
+    }
+    k_msleep( 1 );
+  }
+
+  return true;
+}
+
+/**
+ * @brief Checks the answer of the peer to a previous sum command
+ * 
+ * @param data Bytes sent after the sum command
+ */
+static void _peer_sum_check( zuart_t *zuart, const uint8_t *data, uint32_t len ) {
+
+  char expected[ 24 ];
+  char answer[ 24 ];
+  uint32_t sum = 0;
+
+  for ( uint32_t i = 0; i < len; i++ ) {
+    sum += data[ i ];
+  }
+
+  uint16_t expected_len = snprintf( 
+    expected, sizeof( expected ), "%u %u\r\n", len, sum & 0xFFFF );
+
+  uint16_t answer_len = zuart_read( 
+    zuart, (uint8_t*)answer, expected_len, PEER_TIMEOUT_MS );
+
+  zassert_equal( answer_len, expected_len, "Peer answered %u bytes", answer_len );
+  zassert_mem_equal( answer, expected, expected_len, "Peer received corrupted bytes" );
+}
+
+/**
+ * @brief Requests a pattern to the peer and consumes it, 
+ * used to move the ring buffer indexes to a given offset
+ */
+static void _rx_skip( zuart_t *zuart, uint16_t n_bytes ) {
+
+  char cmd[ 16 ];
+
+  snprintf( cmd, sizeof( cmd ), "pattern %u\n", n_bytes );
+
+  _peer_cmd( zuart, cmd );
+
+  zassert_equal( 
+    zuart_read( zuart, NULL, n_bytes, PEER_TIMEOUT_MS ), n_bytes, 
+    "Pattern not received" );
+}
+
+/**
+ * @brief Reconfigures the baudrate of the suite UART
+ * 
+ * @return int Same as uart_configure()
+ */
+static int _uart_set_baudrate( uint32_t baudrate ) {
+
+  struct uart_config config;
+
+  uart_config_get( ISBD_UART_DEVICE, &config );
+  config.baudrate = baudrate;
+  
+  return uart_configure( ISBD_UART_DEVICE, &config );
+}
+
 static void* zuart_suite_setup(void) {
 
   struct zuart_suite_fixture *fixture = 
@@ -22,6 +173,17 @@ static void* zuart_suite_setup(void) {
 
   zassume_not_null( fixture );
 
+  memset( fixture, 0, sizeof( struct zuart_suite_fixture ) );
+
+  _uart_set_baudrate( PEER_BAUDRATE );
+  
+  return fixture;
+}
+
+static void zuart_suite_before( void *f ) {
+
+  struct zuart_suite_fixture *fixture = f;
+
   // zuart_config_t zuart_config = ZUART_CONF_POLL( (struct device*)ISBD_UART_DEVICE );
 
   zuart_config_t zuart_config = ZUART_CONF_IRQ( 
@@ -29,20 +191,42 @@ static void* zuart_suite_setup(void) {
     fixture->rx_buf, sizeof( fixture->rx_buf ), 
     fixture->tx_buf, sizeof( fixture->tx_buf ) );
 
-  struct uart_config config;
+  fixture->config = zuart_config;
 
-  uart_config_get( ISBD_UART_DEVICE, &config );
-  config.baudrate = 115200;
-  uart_configure( ISBD_UART_DEVICE, &config );
-  
-  zuart_err_t ret = zuart_setup( &fixture->zuart, &zuart_config );
+  _fixture_apply( fixture );
+  _peer_sync( &fixture->zuart );
 
-  zassert_equal( ret, ZUART_OK, "Setup error" );
+  // every test starts with empty buffers at offset 0
+  _fixture_apply( fixture );
 
-  return fixture;
+  fixture->zuart.err = ZUART_OK;
 }
 
-ZTEST_SUITE(zuart_suite, NULL, zuart_suite_setup, NULL, NULL, NULL);
+static void zuart_suite_after( void *f ) {
+
+  struct zuart_suite_fixture *fixture = f;
+
+  if ( fixture->config.mode == ZUART_MODE_TIMER ) {
+    k_timer_stop( &fixture->zuart.rx_poll_timer );
+    _uart_set_baudrate( PEER_BAUDRATE );
+  }
+
+  if ( fixture->config.rx_wake.policy & ZUART_RX_WAKE_IDLE ) {
+    k_timer_stop( &fixture->zuart.rx_idle_timer );
+  }
+}
+
+static void zuart_suite_teardown( void *f ) {
+
+  struct zuart_suite_fixture *fixture = f;
+
+  zuart_write( &fixture->zuart, (const uint8_t*)"close\n", 6, PEER_TIMEOUT_MS );
+
+  k_free( fixture );
+}
+
+ZTEST_SUITE(zuart_suite, NULL, 
+  zuart_suite_setup, zuart_suite_before, zuart_suite_after, zuart_suite_teardown);
 
 
 // uint32_t read_line( zuart_t *zuart ) {
@@ -94,10 +278,6 @@ ZTEST_F( zuart_suite, test_overrun ) {
     zuart_get_err( &fixture->zuart ), ZUART_ERR_OVERRUN, 
     "Overrun not triggered" );
 
-  write_buf_len = sprintf( write_buf, "close\n" );
-
-  zuart_write( &fixture->zuart, write_buf, write_buf_len, 1000 );
-
   // printk( "RX SIZE: %d ~ %d\n", rx_size, (rx_size * 8 * 1000)/19200 );
   // printk( "TX SIZE: %d ~ %d\n", tx_size, (tx_size * 8 * 1000)/19200 );
 
@@ -106,3 +286,481 @@ ZTEST_F( zuart_suite, test_overrun ) {
 	// zassert_not_null("foo", "\"foo\" was NULL");
 	// zassert_equal_ptr(NULL, NULL, "NULL was not equal to NULL");
 }
+
+ZTEST_F( zuart_suite, test_rx_drain_overrun ) {
+
+  uint8_t read_buf[ sizeof( fixture->rx_buf ) ];
+  
+  // the whole hardware FIFO is drained on every interrupt,
+  // bytes which do not fit in the ring buffer are dropped
+  _peer_cmd( &fixture->zuart, "pattern 74\n" );
+
+  zassert_true( 
+    _wait_available( &fixture->zuart, sizeof( fixture->rx_buf ) ), 
+    "Reception not completed" );
+
+  // wait for the bytes to be dropped
+  k_msleep( 100 );
+
+  uint16_t ret = zuart_read( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), 0 );
+
+  zassert_equal( ret, sizeof( read_buf ), "Received %u bytes", ret );
+  zassert_true( 
+    _pattern_check( read_buf, ret, 0 ), "Stored bytes overwritten" );
+
+  zassert_equal( 
+    zuart_get_err( &fixture->zuart ), ZUART_ERR_OVERRUN, 
+    "Overrun not triggered" );
+
+  // dropped bytes are not kept
+  zassert_equal( zuart_available( &fixture->zuart ), 0, "Dropped bytes stored" );
+
+  // reception keeps working after an overrun
+  _peer_cmd( &fixture->zuart, "echo ok\n" );
+
+  ret = zuart_read( &fixture->zuart, read_buf, 4, PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 4, "Reception stalled after overrun" );
+  zassert_mem_equal( read_buf, "ok\r\n", 4, "Corrupted reception" );
+}
+
+ZTEST_F( zuart_suite, test_tx_bulk ) {
+
+  // wraps around the transmission ring buffer more than once
+  uint8_t data[ 3 * sizeof( fixture->tx_buf ) + 7 ];
+  char cmd[ 16 ];
+
+  _pattern_fill( data, sizeof( data ), 0 );
+
+  snprintf( cmd, sizeof( cmd ), "sum %zu\n", sizeof( data ) );
+
+  _peer_cmd( &fixture->zuart, cmd );
+
+  uint16_t ret = zuart_write( 
+    &fixture->zuart, data, sizeof( data ), PEER_TIMEOUT_MS );
+  
+  zassert_equal( ret, sizeof( data ), "Written %u bytes", ret );
+
+  _peer_sum_check( &fixture->zuart, data, sizeof( data ) );
+}
+
+ZTEST_F( zuart_suite, test_tx_low_watermark ) {
+
+  // defaults to half of the transmission buffer
+  zassert_equal( 
+    fixture->zuart.config.tx_low_watermark, sizeof( fixture->tx_buf ) / 2, 
+    "Unexpected default low watermark" );
+
+  fixture->config.tx_low_watermark = 4;
+  _fixture_apply( fixture );
+
+  // one byte more than the transmission buffer, 
+  // so the writer has to wait exactly once
+  uint8_t data[ sizeof( fixture->tx_buf ) + 1 ];
+  char cmd[ 16 ];
+
+  _pattern_fill( data, sizeof( data ), 0 );
+
+  snprintf( cmd, sizeof( cmd ), "sum %zu\n", sizeof( data ) );
+
+  _peer_cmd( &fixture->zuart, cmd );
+
+  zassert_true( _wait_tx_done( &fixture->zuart ), "Transmission not completed" );
+
+  uint16_t ret = zuart_write( 
+    &fixture->zuart, data, sizeof( data ), PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, sizeof( data ), "Written %u bytes", ret );
+
+  // the writer must not be woken up before reaching the watermark
+  zassert_true( 
+    ring_buf_size_get( &fixture->zuart.tx_rbuf ) <= fixture->config.tx_low_watermark + 1, 
+    "Writer woken up above the low watermark" );
+
+  _peer_sum_check( &fixture->zuart, data, sizeof( data ) );
+}
+
+ZTEST_F( zuart_suite, test_wake_any ) {
+
+  uint8_t *data;
+
+  _peer_cmd( &fixture->zuart, "echo a\n" );
+
+  // woken up by the first received chunk
+  uint32_t claimed = zuart_rx_claim( 
+    &fixture->zuart, &data, sizeof( fixture->rx_buf ), PEER_TIMEOUT_MS );
+
+  zassert_true( claimed > 0, "Reader not woken up" );
+  zassert_equal( data[ 0 ], 'a', "Corrupted reception" );
+}
+
+ZTEST_F( zuart_suite, test_wake_bytes ) {
+
+  uint8_t *data;
+
+  fixture->config.rx_wake.policy = ZUART_RX_WAKE_BYTES;
+  fixture->config.rx_wake.bytes = 16;
+  _fixture_apply( fixture );
+
+  _peer_cmd( &fixture->zuart, "echo abc\n" );
+
+  // not enough bytes to wake up the reader
+  uint32_t claimed = zuart_rx_claim( 
+    &fixture->zuart, &data, sizeof( fixture->rx_buf ), 200 );
+
+  zassert_equal( claimed, 0, "Reader woken up with %u bytes", claimed );
+  zassert_equal( zuart_get_err( &fixture->zuart ), ZUART_ERR_TIMEOUT, "Timeout expected" );
+  zassert_equal( zuart_available( &fixture->zuart ), 5, "Bytes not buffered" );
+
+  zuart_drain( &fixture->zuart );
+
+  _peer_cmd( &fixture->zuart, "pattern 20\n" );
+
+  claimed = zuart_rx_claim( 
+    &fixture->zuart, &data, sizeof( fixture->rx_buf ), PEER_TIMEOUT_MS );
+
+  zassert_true( claimed >= 16, "Reader woken up with %u bytes", claimed );
+  zassert_true( _pattern_check( data, claimed, 0 ), "Corrupted reception" );
+}
+
+ZTEST_F( zuart_suite, test_wake_idle ) {
+
+  uint8_t *data;
+
+  // about 9 ms at 115200 bauds
+  fixture->config.rx_wake.policy = ZUART_RX_WAKE_IDLE;
+  fixture->config.rx_wake.idle_chars = 100;
+  _fixture_apply( fixture );
+
+  _peer_cmd( &fixture->zuart, "pattern 32\n" );
+
+  // the whole burst is received before the line becomes idle
+  uint32_t claimed = zuart_rx_claim( 
+    &fixture->zuart, &data, sizeof( fixture->rx_buf ), PEER_TIMEOUT_MS );
+
+  zassert_equal( claimed, 32, "Reader woken up with %u bytes", claimed );
+  zassert_true( _pattern_check( data, claimed, 0 ), "Corrupted reception" );
+}
+
+ZTEST_F( zuart_suite, test_wake_delim ) {
+
+  uint8_t *data;
+
+  fixture->config.rx_wake.policy = ZUART_RX_WAKE_DELIM;
+  fixture->config.rx_wake.delim = '\n';
+  _fixture_apply( fixture );
+
+  _peer_cmd( &fixture->zuart, "pattern 8\n" );
+
+  // no delimiter received
+  uint32_t claimed = zuart_rx_claim( 
+    &fixture->zuart, &data, sizeof( fixture->rx_buf ), 200 );
+
+  zassert_equal( claimed, 0, "Reader woken up with %u bytes", claimed );
+  zassert_equal( zuart_available( &fixture->zuart ), 8, "Bytes not buffered" );
+
+  zuart_drain( &fixture->zuart );
+
+  _peer_cmd( &fixture->zuart, "echo abc\n" );
+
+  claimed = zuart_rx_claim( 
+    &fixture->zuart, &data, sizeof( fixture->rx_buf ), PEER_TIMEOUT_MS );
+
+  zassert_equal( claimed, 5, "Reader woken up with %u bytes", claimed );
+  zassert_mem_equal( data, "abc\r\n", 5, "Corrupted reception" );
+}
+
+ZTEST_F( zuart_suite, test_read_until ) {
+
+  uint8_t read_buf[ 16 ];
+
+  _peer_cmd( &fixture->zuart, "echo first second\n" );
+
+  uint16_t ret = zuart_read_until( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), " ", PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 6, "Read %u bytes", ret );
+  zassert_mem_equal( read_buf, "first ", 6, "Corrupted reception" );
+
+  // the first delimiter found ends the read, whatever its position in the set
+  ret = zuart_read_until( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), "\n\r", PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 7, "Read %u bytes", ret );
+  zassert_mem_equal( read_buf, "second\r", 7, "Corrupted reception" );
+
+  // discard until the end of the line
+  ret = zuart_read_until( 
+    &fixture->zuart, NULL, sizeof( read_buf ), "\n", PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 1, "Discarded %u bytes", ret );
+
+  // the output buffer is filled before finding a delimiter
+  _peer_cmd( &fixture->zuart, "pattern 20\n" );
+
+  ret = zuart_read_until( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), "\n", PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, sizeof( read_buf ), "Read %u bytes", ret );
+  zassert_true( _pattern_check( read_buf, ret, 0 ), "Corrupted reception" );
+
+  // no delimiter before the deadline
+  ret = zuart_read_until( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), "\n", 200 );
+
+  zassert_equal( ret, 4, "Read %u bytes", ret );
+  zassert_equal( zuart_get_err( &fixture->zuart ), ZUART_ERR_TIMEOUT, "Timeout expected" );
+}
+
+ZTEST_F( zuart_suite, test_read_until_wrap ) {
+
+  uint8_t read_buf[ 16 ];
+  uint16_t rx_buf_size = sizeof( fixture->rx_buf );
+
+  // "abc" fits before the end of the ring buffer, 
+  // the delimiters are stored at its beginning
+  _rx_skip( &fixture->zuart, rx_buf_size - 3 );
+  _peer_cmd( &fixture->zuart, "echo abc\n" );
+
+  uint16_t ret = zuart_read_until( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), "\n", PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 5, "Read %u bytes", ret );
+  zassert_mem_equal( read_buf, "abc\r\n", 5, "Corrupted reception" );
+
+  // now "\r" is the last byte of the ring buffer and "\n" the first one,
+  // 2 bytes of the previous line were stored after the wrap
+  _rx_skip( &fixture->zuart, rx_buf_size - 2 - 4 );
+  _peer_cmd( &fixture->zuart, "echo abc\n" );
+
+  ret = zuart_read_until( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), "\n", PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 5, "Read %u bytes", ret );
+  zassert_mem_equal( read_buf, "abc\r\n", 5, "Corrupted reception" );
+
+  // same split, stopping at the delimiter before the wrap
+  _rx_skip( &fixture->zuart, rx_buf_size - 5 );
+  _peer_cmd( &fixture->zuart, "echo abc\n" );
+
+  ret = zuart_read_until( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), "\r\n", PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 4, "Read %u bytes", ret );
+  zassert_mem_equal( read_buf, "abc\r", 4, "Corrupted reception" );
+
+  ret = zuart_read_until( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), "\r\n", PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 1, "Read %u bytes", ret );
+  zassert_equal( read_buf[ 0 ], '\n', "Corrupted reception" );
+}
+
+ZTEST_F( zuart_suite, test_rx_claim_wrap ) {
+
+  uint8_t *data;
+  uint8_t peek_buf[ 16 ];
+  uint16_t rx_buf_size = sizeof( fixture->rx_buf );
+
+  zassert_true( zuart_rx_claim_supported( &fixture->zuart ), "Claim not supported" );
+
+  // the last 8 bytes of the ring buffer are stored
+  // before the wrap and the remaining ones after it
+  _rx_skip( &fixture->zuart, rx_buf_size - 8 );
+  _peer_cmd( &fixture->zuart, "pattern 16\n" );
+
+  zassert_true( _wait_available( &fixture->zuart, 16 ), "Reception not completed" );
+
+  // peeking handles the wrap and does not consume anything
+  uint32_t ret = zuart_rx_peek( &fixture->zuart, peek_buf, sizeof( peek_buf ) );
+
+  zassert_equal( ret, 16, "Peeked %u bytes", ret );
+  zassert_true( _pattern_check( peek_buf, ret, 0 ), "Corrupted peek" );
+  zassert_equal( zuart_available( &fixture->zuart ), 16, "Peek consumed bytes" );
+
+  // claimed regions are contiguous, so they end at the wrap
+  ret = zuart_rx_claim( &fixture->zuart, &data, 16, PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 8, "Claimed %u bytes", ret );
+  zassert_equal_ptr( data, &fixture->rx_buf[ rx_buf_size - 8 ], "Not claimed in place" );
+  zassert_true( _pattern_check( data, ret, 0 ), "Corrupted claim" );
+  zassert_equal( zuart_rx_finish( &fixture->zuart, 8 ), ZUART_OK, "Finish error" );
+
+  ret = zuart_rx_claim( &fixture->zuart, &data, 16, PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 8, "Claimed %u bytes", ret );
+  zassert_equal_ptr( data, fixture->rx_buf, "Not claimed in place" );
+  zassert_true( _pattern_check( data, ret, 8 ), "Corrupted claim" );
+
+  // partially consumed, the rest is claimed again
+  zassert_equal( zuart_rx_finish( &fixture->zuart, 4 ), ZUART_OK, "Finish error" );
+
+  ret = zuart_rx_claim( &fixture->zuart, &data, 16, PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 4, "Claimed %u bytes", ret );
+  zassert_true( _pattern_check( data, ret, 12 ), "Corrupted claim" );
+
+  // can not consume more than the claimed bytes
+  zassert_equal( zuart_rx_finish( &fixture->zuart, 5 ), ZUART_ERR, "Finish overflow" );
+  zassert_equal( zuart_rx_finish( &fixture->zuart, 4 ), ZUART_OK, "Finish error" );
+
+  zassert_equal( zuart_available( &fixture->zuart ), 0, "Bytes not consumed" );
+
+  // nothing left to claim
+  ret = zuart_rx_claim( &fixture->zuart, &data, 16, 100 );
+
+  zassert_equal( ret, 0, "Claimed %u bytes", ret );
+  zassert_equal( zuart_get_err( &fixture->zuart ), ZUART_ERR_TIMEOUT, "Timeout expected" );
+}
+
+ZTEST_F( zuart_suite, test_stats ) {
+
+  Z_TEST_SKIP_IFNDEF( CONFIG_Z_UART_STATS );
+
+  zuart_stats_t stats;
+  zuart_stats_t zero_stats = { 0 };
+  uint8_t read_buf[ 8 ];
+
+  zuart_stats_reset( &fixture->zuart );
+
+  // 9 bytes sent, 5 bytes received
+  _peer_cmd( &fixture->zuart, "echo abc\n" );
+
+  zassert_equal( 
+    zuart_read_until( &fixture->zuart, read_buf, sizeof( read_buf ), "\n", PEER_TIMEOUT_MS ), 5, 
+    "Echo not received" );
+  
+  zassert_true( _wait_tx_done( &fixture->zuart ), "Transmission not completed" );
+
+  // nothing else to receive
+  zuart_read( &fixture->zuart, read_buf, 1, 10 );
+
+  zuart_stats_get( &fixture->zuart, &stats );
+
+  zassert_equal( stats.rx_bytes, 5, "rx_bytes: %u", stats.rx_bytes );
+  zassert_equal( stats.tx_bytes, 9, "tx_bytes: %u", stats.tx_bytes );
+  zassert_true( stats.isr_calls > 0, "ISR calls not counted" );
+  zassert_equal( stats.rx_dropped, 0, "rx_dropped: %u", stats.rx_dropped );
+  zassert_equal( stats.rx_timeouts, 1, "rx_timeouts: %u", stats.rx_timeouts );
+  zassert_equal( stats.tx_timeouts, 0, "tx_timeouts: %u", stats.tx_timeouts );
+  zassert_between_inclusive( stats.rx_peak, 1, 5, "rx_peak: %u", stats.rx_peak );
+  zassert_equal( stats.tx_peak, 9, "tx_peak: %u", stats.tx_peak );
+  zassert_true( stats.rx_wait_ticks > 0, "Blocked time not accounted" );
+
+  zuart_stats_reset( &fixture->zuart );
+
+  // 10 bytes more than the reception buffer
+  _peer_cmd( &fixture->zuart, "pattern 74\n" );
+
+  zassert_true( 
+    _wait_available( &fixture->zuart, sizeof( fixture->rx_buf ) ), 
+    "Reception not completed" );
+
+  k_msleep( 100 );
+
+  zuart_stats_get( &fixture->zuart, &stats );
+
+  zassert_equal( stats.rx_bytes, sizeof( fixture->rx_buf ), "rx_bytes: %u", stats.rx_bytes );
+  zassert_equal( stats.rx_dropped, 10, "rx_dropped: %u", stats.rx_dropped );
+  zassert_equal( stats.rx_peak, sizeof( fixture->rx_buf ), "rx_peak: %u", stats.rx_peak );
+
+  zuart_stats_reset( &fixture->zuart );
+  zuart_stats_get( &fixture->zuart, &stats );
+
+  zassert_mem_equal( &stats, &zero_stats, sizeof( stats ), "Statistics not reset" );
+}
+
+ZTEST_F( zuart_suite, test_timer_mode ) {
+
+  uint8_t read_buf[ 48 ];
+
+  // the UART is sampled from a timer, interrupts must not drain it
+  uart_irq_rx_disable( ISBD_UART_DEVICE );
+
+  zuart_config_t zuart_config = ZUART_CONF_TIMER( 
+    (struct device*)ISBD_UART_DEVICE, 
+    fixture->rx_buf, sizeof( fixture->rx_buf ) );
+
+  fixture->config = zuart_config;
+
+  // ! A single character FIFO at 115200 bauds (87 us) overruns 
+  // ! before the next 100 us tick, see prj.conf
+  if ( _uart_set_baudrate( PEER_BAUDRATE ) == 0 ) {
+    
+    zassert_equal( 
+      zuart_setup( &fixture->zuart, &fixture->config ), ZUART_ERR_SETUP, 
+      "Sampling period longer than the FIFO fill time accepted" );
+
+    // the peer is connected through a PTY, the baudrate is not enforced
+    _uart_set_baudrate( 9600 );
+  }
+
+  _fixture_apply( fixture );
+
+  _peer_cmd( &fixture->zuart, "echo timer mode\n" );
+
+  // readers block until the timer stores received bytes
+  uint16_t ret = zuart_read_until( 
+    &fixture->zuart, read_buf, sizeof( read_buf ), "\n", PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, 12, "Read %u bytes", ret );
+  zassert_mem_equal( read_buf, "timer mode\r\n", 12, "Corrupted reception" );
+
+  // longer than the hardware FIFO
+  _peer_cmd( &fixture->zuart, "pattern 48\n" );
+
+  ret = zuart_read( &fixture->zuart, read_buf, sizeof( read_buf ), PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, sizeof( read_buf ), "Read %u bytes", ret );
+  zassert_true( _pattern_check( read_buf, ret, 0 ), "Corrupted reception" );
+  zassert_equal( zuart_get_err( &fixture->zuart ), ZUART_OK, "Unexpected error" );
+}
+
+/**
+ * @brief Sends a sum command, a payload and its checksum as separate segments
+ */
+static void _writev_check( zuart_t *zuart ) {
+
+  char cmd[ 16 ];
+  uint8_t payload[ 100 ];
+  uint8_t checksum[ 2 ] = { 0x12, 0x34 };
+  uint8_t sent[ sizeof( payload ) + sizeof( checksum ) ];
+
+  _pattern_fill( payload, sizeof( payload ), 0 );
+
+  memcpy( sent, payload, sizeof( payload ) );
+  memcpy( sent + sizeof( payload ), checksum, sizeof( checksum ) );
+
+  uint16_t cmd_len = snprintf( cmd, sizeof( cmd ), "sum %zu\n", sizeof( sent ) );
+
+  zuart_iovec_t iov[] = {
+    { .buf = (const uint8_t*)cmd, .len = cmd_len },
+    { .buf = payload, .len = sizeof( payload ) },
+    { .buf = checksum, .len = sizeof( checksum ) },
+  };
+
+  uint32_t ret = zuart_writev( zuart, iov, ARRAY_SIZE( iov ), PEER_TIMEOUT_MS );
+
+  zassert_equal( ret, cmd_len + sizeof( sent ), "Written %u bytes", ret );
+
+  _peer_sum_check( zuart, sent, sizeof( sent ) );
+}
+
+ZTEST_F( zuart_suite, test_writev ) {
+  // segments longer than the transmission ring buffer
+  _writev_check( &fixture->zuart );
+}
+
+ZTEST_F( zuart_suite, test_writev_poll ) {
+
+  zuart_config_t zuart_config = ZUART_CONF_MIX_RX_IRQ_TX_POLL( 
+    (struct device*)ISBD_UART_DEVICE, 
+    fixture->rx_buf, sizeof( fixture->rx_buf ) );
+
+  fixture->config = zuart_config;
+  _fixture_apply( fixture );
+
+  // unbuffered modes write segments one after another
+  _writev_check( &fixture->zuart );
+}
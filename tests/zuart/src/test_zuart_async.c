@@ -0,0 +1,169 @@
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/drivers/serial/uart_emul.h>
+
+#include "zuart.h"
+
+#define EMUL_UART_NODE        DT_NODELABEL( euart0 )
+#define EMUL_UART_DEVICE      DEVICE_DT_GET( EMUL_UART_NODE )
+
+#define ASYNC_TIMEOUT_MS      1000
+
+struct zuart_async_suite_fixture {
+  zuart_t zuart;
+  uint8_t rx_buf[ 4 * CONFIG_Z_UART_ASYNC_RX_BUF_SIZE ];
+  uint8_t tx_buf[64];
+};
+
+static void _pattern_fill( uint8_t *buf, uint32_t len ) {
+  for ( uint32_t i = 0; i < len; i++ ) {
+    buf[ i ] = 'a' + i % 26;
+  }
+}
+
+/**
+ * @brief Waits until the given number of bytes has been stored
+ * in the reception ring buffer
+ */
+static bool _wait_available( zuart_t *zuart, uint16_t n_bytes ) {
+
+  k_timepoint_t deadline = sys_timepoint_calc( K_MSEC( ASYNC_TIMEOUT_MS ) );
+
+  while ( zuart_available( zuart ) < n_bytes ) {
+    if ( sys_timepoint_expired( deadline ) ) {
+      return false;
+    }
+    k_msleep( 1 );
+  }
+
+  return true;
+}
+
+/**
+ * @brief Waits until the transmission ring buffer has been
+ * completely handed to the driver and the last transfer is done
+ */
+static bool _wait_tx_done( zuart_t *zuart ) {
+
+  k_timepoint_t deadline = sys_timepoint_calc( K_MSEC( ASYNC_TIMEOUT_MS ) );
+
+  while ( !ring_buf_is_empty( &zuart->tx_rbuf )
+      || atomic_get( &zuart->async.tx_busy ) ) {
+    if ( sys_timepoint_expired( deadline ) ) {
+      return false;
+    }
+    k_msleep( 1 );
+  }
+
+  return true;
+}
+
+static void* zuart_async_suite_setup(void) {
+
+  struct zuart_async_suite_fixture *fixture =
+    k_malloc( sizeof( struct zuart_async_suite_fixture ) );
+
+  zassume_not_null( fixture );
+
+  zuart_config_t zuart_config = ZUART_CONF_ASYNC(
+    (struct device*)EMUL_UART_DEVICE,
+    fixture->rx_buf, sizeof( fixture->rx_buf ),
+    fixture->tx_buf, sizeof( fixture->tx_buf ) );
+
+  zuart_err_t ret = zuart_setup( &fixture->zuart, &zuart_config );
+
+  zassert_equal( ret, ZUART_OK, "Setup error" );
+
+  return fixture;
+}
+
+static void zuart_async_suite_before( void *f ) {
+
+  struct zuart_async_suite_fixture *fixture = f;
+
+  uart_emul_flush_rx_data( EMUL_UART_DEVICE );
+  uart_emul_flush_tx_data( EMUL_UART_DEVICE );
+
+  zuart_drain( &fixture->zuart );
+  fixture->zuart.err = ZUART_OK;
+}
+
+static void zuart_async_suite_teardown( void *f ) {
+  k_free( f );
+}
+
+ZTEST_SUITE( zuart_async_suite, NULL,
+  zuart_async_suite_setup, zuart_async_suite_before, NULL, zuart_async_suite_teardown );
+
+
+ZTEST_F( zuart_async_suite, test_async_rx_double_buffer ) {
+
+  // spans both DMA buffers more than once
+  uint8_t data[ 2 * CONFIG_Z_UART_ASYNC_RX_BUF_SIZE + CONFIG_Z_UART_ASYNC_RX_BUF_SIZE / 2 ];
+  uint8_t read_buf[ sizeof( data ) ];
+
+  _pattern_fill( data, sizeof( data ) );
+
+  zassert_equal(
+    uart_emul_put_rx_data( EMUL_UART_DEVICE, data, sizeof( data ) ), sizeof( data ),
+    "Emulated RX FIFO too small" );
+
+  uint16_t ret = zuart_read(
+    &fixture->zuart, read_buf, sizeof( read_buf ), ASYNC_TIMEOUT_MS );
+
+  zassert_equal( ret, sizeof( data ), "Received %u bytes", ret );
+  zassert_mem_equal( read_buf, data, sizeof( data ), "Corrupted reception" );
+  zassert_equal( zuart_get_err( &fixture->zuart ), ZUART_OK, "Unexpected error" );
+}
+
+ZTEST_F( zuart_async_suite, test_async_tx ) {
+
+  // longer than the transmission ring buffer,
+  // so more than one DMA transfer is needed
+  uint8_t data[ 2 * sizeof( fixture->tx_buf ) + 22 ];
+  uint8_t sent_buf[ sizeof( data ) + 1 ];
+
+  _pattern_fill( data, sizeof( data ) );
+
+  uint16_t ret = zuart_write(
+    &fixture->zuart, data, sizeof( data ), ASYNC_TIMEOUT_MS );
+
+  zassert_equal( ret, sizeof( data ), "Written %u bytes", ret );
+  zassert_true( _wait_tx_done( &fixture->zuart ), "Transmission not completed" );
+
+  uint32_t sent = uart_emul_get_tx_data(
+    EMUL_UART_DEVICE, sent_buf, sizeof( sent_buf ) );
+
+  zassert_equal( sent, sizeof( data ), "Transmitted %u bytes", sent );
+  zassert_mem_equal( sent_buf, data, sizeof( data ), "Corrupted transmission" );
+}
+
+ZTEST_F( zuart_async_suite, test_async_overrun ) {
+
+  uint8_t data[ sizeof( fixture->rx_buf ) ];
+  uint8_t read_buf[ sizeof( data ) ];
+
+  _pattern_fill( data, sizeof( data ) );
+
+  // fill the whole reception ring buffer
+  uart_emul_put_rx_data( EMUL_UART_DEVICE, data, sizeof( data ) );
+
+  zassert_true(
+    _wait_available( &fixture->zuart, sizeof( data ) ), "Reception not completed" );
+
+  // no space left, this bytes have to be dropped
+  uart_emul_put_rx_data( EMUL_UART_DEVICE, data, 8 );
+
+  k_msleep( 10 );
+
+  uint16_t ret = zuart_read( &fixture->zuart, read_buf, sizeof( read_buf ), 0 );
+
+  zassert_equal( ret, sizeof( data ), "Received %u bytes", ret );
+  zassert_mem_equal( read_buf, data, sizeof( data ), "Stored bytes overwritten" );
+  zassert_equal(
+    zuart_get_err( &fixture->zuart ), ZUART_ERR_OVERRUN,
+    "Overrun not triggered" );
+}
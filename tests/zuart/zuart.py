@@ -30,6 +30,14 @@ while 1:
     elif argv[ 0 ] == "flood":
         size = int( argv[ 1 ] )
         ser.write( bytearray( size ) )
+    elif argv[ 0 ] == "pattern":
+        size = int( argv[ 1 ] )
+        ser.write( bytearray( ord( 'a' ) + i % 26 for i in range( size ) ) )
+    elif argv[ 0 ] == "echo":
+        ser.write( ( ' '.join( argv[1:] ) + '\r\n' ).encode( 'ascii' ) )
+    elif argv[ 0 ] == "sum":
+        data = ser.read( int( argv[ 1 ] ) )
+        ser.write( ( "%d %d\r\n" % ( len( data ), sum( data ) & 0xFFFF ) ).encode( 'ascii' ) )
     elif argv[ 0 ] == "close":
         ser.close()
         break